@@ -0,0 +1,551 @@
+// Microbenchmarks for the lostgba hot paths. Build with `make bench` and run bench.gba in mGBA, e.g.
+//
+//     mgba -l 31 bench.gba
+//
+// Each benchmark is run BENCH_ITERATIONS times and reported as one `PROFILE name=...` line (see Profile_Report()).
+// The last line is `BENCH done`, logged as fatal so that mGBA stops once everything has been reported.
+
+#include <lostgba/Background.h>
+#include <lostgba/Bitmap.h>
+#include <lostgba/DebugLog.h>
+#include <lostgba/Entity.h>
+#include <lostgba/Interrupt.h>
+#include <lostgba/ObjectAttribute.h>
+#include <lostgba/Palette.h>
+#include <lostgba/Profile.h>
+#include <lostgba/Sound.h>
+#include <lostgba/Sprite.h>
+#include <lostgba/SpriteMultiplexer.h>
+#include <lostgba/SystemCalls.h>
+#include <lostgba/Text.h>
+#include <lostgba/TileMap.h>
+
+#include <whale.h>
+#include <tilemap.h>
+
+#define BENCH_ITERATIONS 16
+
+enum BenchZoneId
+{
+    BenchZoneId_OamCopyAll,
+    BenchZoneId_OamCopyOneGroup,
+    BenchZoneId_SpriteCommit,
+    BenchZoneId_MapSetRow,
+    BenchZoneId_MapSetTile,
+    BenchZoneId_MapFillRect,
+    BenchZoneId_SpriteTileCopy,
+    BenchZoneId_BackgroundTileDecompress,
+    BenchZoneId_PaletteDecompress,
+    BenchZoneId_ObjectAttributeSetters,
+    BenchZoneId_ObjectAttributeBuild,
+    BenchZoneId_SoundMixOne,
+    BenchZoneId_SoundMixAll,
+    BenchZoneId_BitmapClearMode3,
+    BenchZoneId_BitmapClearMode4,
+    BenchZoneId_BitmapBlitMode3,
+    BenchZoneId_BitmapBlitMode4,
+    BenchZoneId_BitmapLinesMode4,
+    BenchZoneId_PaletteFadeAll,
+    BenchZoneId_PaletteTintAll,
+    BenchZoneId_PaletteUploadAll,
+    BenchZoneId_PaletteUploadOneBank,
+    BenchZoneId_TextPrintCached,
+    BenchZoneId_TextPrintUncached,
+    BenchZoneId_TextLabelSet,
+    BenchZoneId_EntityUpdate,
+    BenchZoneId_SpriteMultiplexerCommit,
+    BenchZoneId_SpriteMultiplexerBand,
+    BenchZoneId_SpriteMultiplexerVBlank,
+    BenchZoneId_Count,
+};
+
+_Static_assert(BenchZoneId_Count <= Profile_MaxZones, "Every benchmark needs its own profile zone");
+
+static const char *const benchZoneNames[] = {
+    [BenchZoneId_OamCopyAll] = "oam_copy_all",
+    [BenchZoneId_OamCopyOneGroup] = "oam_copy_one_group",
+    [BenchZoneId_SpriteCommit] = "sprite_commit_128",
+    [BenchZoneId_MapSetRow] = "map_32x32_set_row",
+    [BenchZoneId_MapSetTile] = "map_32x32_set_tile",
+    [BenchZoneId_MapFillRect] = "map_32x32_fill_rect",
+    [BenchZoneId_SpriteTileCopy] = "sprite_tiles_copy",
+    [BenchZoneId_BackgroundTileDecompress] = "background_tiles_decompress",
+    [BenchZoneId_PaletteDecompress] = "palette_decompress",
+    [BenchZoneId_ObjectAttributeSetters] = "object_attribute_setters_128",
+    [BenchZoneId_ObjectAttributeBuild] = "object_attribute_build_128",
+    [BenchZoneId_SoundMixOne] = "sound_mix_1",
+    [BenchZoneId_SoundMixAll] = "sound_mix_8",
+    [BenchZoneId_BitmapClearMode3] = "bitmap_clear_mode3",
+    [BenchZoneId_BitmapClearMode4] = "bitmap_clear_mode4",
+    [BenchZoneId_BitmapBlitMode3] = "bitmap_blit_64x64_mode3",
+    [BenchZoneId_BitmapBlitMode4] = "bitmap_blit_64x64_mode4",
+    [BenchZoneId_BitmapLinesMode4] = "bitmap_lines_64_mode4",
+    [BenchZoneId_PaletteFadeAll] = "palette_fade_512",
+    [BenchZoneId_PaletteTintAll] = "palette_tint_512",
+    [BenchZoneId_PaletteUploadAll] = "palette_upload_all",
+    [BenchZoneId_PaletteUploadOneBank] = "palette_upload_one_bank",
+    [BenchZoneId_TextPrintCached] = "text_print_30_cached",
+    [BenchZoneId_TextPrintUncached] = "text_print_30_uncached",
+    [BenchZoneId_TextLabelSet] = "text_label_set_16_tiles",
+    [BenchZoneId_EntityUpdate] = "entity_update_128",
+    [BenchZoneId_SpriteMultiplexerCommit] = "sprite_multiplexer_commit_384",
+    [BenchZoneId_SpriteMultiplexerBand] = "sprite_multiplexer_band",
+    [BenchZoneId_SpriteMultiplexerVBlank] = "sprite_multiplexer_vblank_384",
+};
+
+_Static_assert(sizeof(benchZoneNames) / sizeof(benchZoneNames[0]) == BenchZoneId_Count, "Every benchmark needs a name");
+
+#define BENCH_SCREEN_BLOCK 30
+
+static void benchOam(void)
+{
+    for (int i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        ObjectAttributeBuffer_MarkAllDirty();
+
+        Profile_Begin(BenchZoneId_OamCopyAll);
+        ObjectAttributeBuffer_CopyBufferToMemory();
+        Profile_End(BenchZoneId_OamCopyAll);
+
+        ObjectAttributeBuffer_MarkDirty(&objectAttributeBuffer[i]);
+
+        Profile_Begin(BenchZoneId_OamCopyOneGroup);
+        ObjectAttributeBuffer_CopyBufferToMemory();
+        Profile_End(BenchZoneId_OamCopyOneGroup);
+    }
+}
+
+static void benchSpriteCommit(void)
+{
+    Sprite_Init();
+
+    for (int i = 0; i < Sprite_MaxSprites; i++)
+    {
+        SpriteHandle handle = Sprite_Alloc();
+        ObjectAttribute_SetPriority(Sprite_GetAttribute(handle), i & 3);
+        Sprite_SetDepth(handle, (i * 37) & 0xff);
+    }
+
+    for (int i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        // Move everything each time so that every slot actually gets rewritten
+        for (int handle = 0; handle < Sprite_MaxSprites; handle++)
+        {
+            ObjectAttribute_SetPos(Sprite_GetAttribute(handle), i, handle);
+        }
+
+        Profile_Begin(BenchZoneId_SpriteCommit);
+        Sprite_Commit();
+        Profile_End(BenchZoneId_SpriteCommit);
+    }
+}
+
+static void benchMap(void)
+{
+    u16 row[32];
+    for (int x = 0; x < 32; x++)
+    {
+        row[x] = Background_MakeScreenEntry(x & 1, false, false, 0);
+    }
+
+    for (int i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        Profile_Begin(BenchZoneId_MapSetRow);
+        for (int y = 0; y < 32; y++)
+        {
+            Background_SetRow(BENCH_SCREEN_BLOCK, BackgroundSize_32x32, 0, y, row, 32);
+        }
+        Profile_End(BenchZoneId_MapSetRow);
+
+        Profile_Begin(BenchZoneId_MapSetTile);
+        for (int y = 0; y < 32; y++)
+        {
+            for (int x = 0; x < 32; x++)
+            {
+                Background_SetTile(BENCH_SCREEN_BLOCK, BackgroundSize_32x32, x, y, x & 1, false, false, 0);
+            }
+        }
+        Profile_End(BenchZoneId_MapSetTile);
+
+        Profile_Begin(BenchZoneId_MapFillRect);
+        Background_FillRect(BENCH_SCREEN_BLOCK, BackgroundSize_32x32, 0, 0, 32, 32, row[0]);
+        Profile_End(BenchZoneId_MapFillRect);
+    }
+}
+
+static void benchLoads(void)
+{
+    for (int i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        Profile_Begin(BenchZoneId_SpriteTileCopy);
+        TileMap_CopyToSpriteTiles(0, whaleTiles, whaleTilesLen);
+        Profile_End(BenchZoneId_SpriteTileCopy);
+
+        Profile_Begin(BenchZoneId_BackgroundTileDecompress);
+        TileMap_LoadCompressedBackgroundTiles(0, tilemapTiles);
+        Profile_End(BenchZoneId_BackgroundTileDecompress);
+
+        Profile_Begin(BenchZoneId_PaletteDecompress);
+        TileMap_LoadCompressedSpritePalette(whalePal);
+        Profile_End(BenchZoneId_PaletteDecompress);
+    }
+}
+
+static void benchObjectAttributes(void)
+{
+    for (int i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        Profile_Begin(BenchZoneId_ObjectAttributeSetters);
+        for (int j = 0; j < ObjectAttributeBuffer_Length; j++)
+        {
+            struct ObjectAttribute *attr = &objectAttributeBuffer[j];
+
+            ObjectAttribute_SetPos(attr, i, j);
+            ObjectAttribute_SetDisplayMode(attr, ObjectAttributeDisplayMode_Normal);
+            ObjectAttribute_SetShape(attr, ObjectAttributeShape_Square);
+            ObjectAttribute_SetSize(attr, ObjectAttributeSize_16);
+            ObjectAttribute_SetTile(attr, j);
+            ObjectAttribute_SetPriority(attr, j & 3);
+            ObjectAttribute_SetPaletteBank(attr, 0);
+        }
+        Profile_End(BenchZoneId_ObjectAttributeSetters);
+
+        Profile_Begin(BenchZoneId_ObjectAttributeBuild);
+        for (int j = 0; j < ObjectAttributeBuffer_Length; j++)
+        {
+            ObjectAttribute_Build(&objectAttributeBuffer[j], &(struct ObjectAttributeDescriptor){
+                                                                 .x = i,
+                                                                 .y = j,
+                                                                 .shape = ObjectAttributeShape_Square,
+                                                                 .size = ObjectAttributeSize_16,
+                                                                 .tileId = j,
+                                                                 .priority = j & 3,
+                                                             });
+        }
+        Profile_End(BenchZoneId_ObjectAttributeBuild);
+    }
+}
+
+#define BENCH_SOUND_LENGTH 1024
+
+static void benchSoundMix(int zone)
+{
+    for (int i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        // Sound_Mix() does nothing until the VBlank handler has taken the last mix
+        SystemCall_WaitForVBlank();
+
+        LOSTGBA_UNSAFE(Profile_Begin)(zone);
+        Sound_Mix();
+        LOSTGBA_UNSAFE(Profile_End)(zone);
+    }
+}
+
+static void benchSound(void)
+{
+    static s8 soundData[BENCH_SOUND_LENGTH];
+    for (int i = 0; i < BENCH_SOUND_LENGTH; i++)
+    {
+        soundData[i] = (i * 37) & 0xff;
+    }
+
+    const struct SoundSample sample = {
+        .data = soundData,
+        .length = BENCH_SOUND_LENGTH,
+        .loopStart = 0,
+        .rate = Sound_MixRate,
+    };
+
+    Sound_Init();
+
+    Sound_SetPitch(Sound_Play(&sample, Sound_MaxVolume, 0), Fixed16_One + Fixed16_One / 3);
+    benchSoundMix(BenchZoneId_SoundMixOne);
+
+    // The worst case, which is what the mixer costs however many sounds are triggered
+    for (int i = 1; i < Sound_ChannelCount; i++)
+    {
+        Sound_SetPitch(Sound_Play(&sample, Sound_MaxVolume / 2, i * 16 - Sound_MaxPan), Fixed16_One / 2 + i * Fixed16_One / 4);
+    }
+    benchSoundMix(BenchZoneId_SoundMixAll);
+
+    Sound_StopAll();
+}
+
+#define BENCH_BLIT_SIZE 64
+
+static void benchBitmap(void)
+{
+    // Nothing is displayed, so the graphics mode is left alone and this just draws over VRAM
+    static u16 image[BENCH_BLIT_SIZE * BENCH_BLIT_SIZE];
+    for (int i = 0; i < BENCH_BLIT_SIZE * BENCH_BLIT_SIZE; i++)
+    {
+        image[i] = i * 0x1234;
+    }
+
+    Bitmap_Init(GraphicsMode_3);
+    for (int i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        Profile_Begin(BenchZoneId_BitmapClearMode3);
+        Bitmap_Clear(i);
+        Profile_End(BenchZoneId_BitmapClearMode3);
+
+        Profile_Begin(BenchZoneId_BitmapBlitMode3);
+        Bitmap_Blit(i, i, image, BENCH_BLIT_SIZE, BENCH_BLIT_SIZE, BENCH_BLIT_SIZE);
+        Profile_End(BenchZoneId_BitmapBlitMode3);
+    }
+
+    // The same image again, viewed as twice as many 8 bit pixels
+    Bitmap_Init(GraphicsMode_4);
+    for (int i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        Profile_Begin(BenchZoneId_BitmapClearMode4);
+        Bitmap_Clear(i);
+        Profile_End(BenchZoneId_BitmapClearMode4);
+
+        Profile_Begin(BenchZoneId_BitmapBlitMode4);
+        Bitmap_Blit(i, i, image, BENCH_BLIT_SIZE, BENCH_BLIT_SIZE, BENCH_BLIT_SIZE);
+        Profile_End(BenchZoneId_BitmapBlitMode4);
+
+        Profile_Begin(BenchZoneId_BitmapLinesMode4);
+        for (int line = 0; line < 64; line++)
+        {
+            Bitmap_DrawLine(line * 3, 0, Graphics_ScreenWidth - 1 - line * 3, Graphics_ScreenHeight - 1, line);
+        }
+        Profile_End(BenchZoneId_BitmapLinesMode4);
+    }
+}
+
+static void benchPalette(void)
+{
+    Palette_LoadCompressed(PaletteType_Background, tilemapPal);
+    Palette_LoadCompressed(PaletteType_Sprite, whalePal);
+
+    for (int i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        Profile_Begin(BenchZoneId_PaletteFadeAll);
+        Palette_Fade(Palette_AllBanks, Palette_Black, i * 2);
+        Profile_End(BenchZoneId_PaletteFadeAll);
+
+        Profile_Begin(BenchZoneId_PaletteTintAll);
+        Palette_Tint(Palette_AllBanks, Palette_MakeColour(31, i, 31 - i));
+        Profile_End(BenchZoneId_PaletteTintAll);
+
+        Profile_Begin(BenchZoneId_PaletteUploadAll);
+        PaletteBuffer_CopyBufferToMemory();
+        Profile_End(BenchZoneId_PaletteUploadAll);
+
+        Palette_SetColour(PaletteType_Sprite, i, Palette_White);
+
+        Profile_Begin(BenchZoneId_PaletteUploadOneBank);
+        PaletteBuffer_CopyBufferToMemory();
+        Profile_End(BenchZoneId_PaletteUploadOneBank);
+    }
+}
+
+static void benchText(void)
+{
+    static const char line[] = "The quick brown fox jumps over";
+
+    struct TextLayer layer;
+    struct TextLayerSettings layerSettings = {
+        .tileBlock = 1,
+        .firstTile = 0,
+        .cachedGlyphs = TextLayer_MaxCachedGlyphs,
+        .screenBaseBlock = 31,
+        .backgroundSize = BackgroundSize_32x32,
+        .paletteBank = 15,
+        .colour = 1,
+    };
+
+    struct TextLabel label;
+    TextLabel_Init(&label, &Text_DefaultFont, (struct TextLabelSettings){
+                                                  .tileBlock = 1,
+                                                  .firstTile = 128,
+                                                  .widthInTiles = TextLabel_MaxTiles,
+                                                  .screenBaseBlock = 31,
+                                                  .backgroundSize = BackgroundSize_32x32,
+                                                  .x = 0,
+                                                  .y = 20,
+                                                  .paletteBank = 15,
+                                                  .colour = 1,
+                                              });
+
+    for (int i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        // Starting from an empty cache every time, so every glyph gets uploaded
+        TextLayer_Init(&layer, &Text_DefaultFont, layerSettings);
+
+        Profile_Begin(BenchZoneId_TextPrintUncached);
+        TextLayer_Print(&layer, 0, i, line);
+        Profile_End(BenchZoneId_TextPrintUncached);
+
+        Profile_Begin(BenchZoneId_TextPrintCached);
+        TextLayer_Print(&layer, 0, i, line);
+        Profile_End(BenchZoneId_TextPrintCached);
+
+        // Alternate so that the label always changes
+        Profile_Begin(BenchZoneId_TextLabelSet);
+        TextLabel_Set(&label, (i & 1) ? "Score 123456789" : "Whales blown: 42");
+        Profile_End(BenchZoneId_TextLabelSet);
+    }
+}
+
+static const struct AnimationFrame benchEntityFrames[] = {
+    {.tile = 0, .duration = 3},
+    {.tile = 4, .duration = 3, .offsetY = 1},
+};
+static const struct AnimationClip benchEntityClip = ANIMATION_CLIP(benchEntityFrames, AnimationLoopMode_Loop);
+
+static void benchEntities(void)
+{
+    Sprite_Init();
+    Entity_Init();
+
+    for (int i = 0; i < Entity_MaxEntities; i++)
+    {
+        EntityHandle entity = Entity_Create(Fixed16_FromInt(i), Fixed16_FromInt(i & 127),
+                                            &(struct ObjectAttributeDescriptor){.size = ObjectAttributeSize_16});
+        Entity_SetVelocity(entity, Fixed16_One + i * 512, Fixed16_One - i * 1024);
+        Entity_SetEdgeMode(entity, EntityEdgeMode_Bounce);
+        Entity_Play(entity, &benchEntityClip);
+    }
+
+    for (int i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        Profile_Begin(BenchZoneId_EntityUpdate);
+        Entity_UpdateAll();
+        Profile_End(BenchZoneId_EntityUpdate);
+    }
+}
+
+static void benchSpriteMultiplexerBandBegin(void)
+{
+    Profile_Begin(BenchZoneId_SpriteMultiplexerBand);
+}
+
+static void benchSpriteMultiplexerBandEnd(void)
+{
+    Profile_End(BenchZoneId_SpriteMultiplexerBand);
+}
+
+// Times the VCount handler copying a full band, by wrapping it in handlers which run just before and after it
+static void benchSpriteMultiplexerBand(void)
+{
+    SpriteMultiplexer_Init(0);
+
+    // Fill every slot until line 8, and then reuse as many as one band allows from line 12
+    for (int i = 0; i < ObjectAttributeBuffer_Length + SpriteMultiplexer_MaxWritesPerBand; i++)
+    {
+        ObjectAttribute_Build(SpriteMultiplexer_GetAttribute(SpriteMultiplexer_Alloc()),
+                              &(struct ObjectAttributeDescriptor){
+                                  .x = (i * 8) % Graphics_ScreenWidth,
+                                  .y = i < ObjectAttributeBuffer_Length ? 0 : 12,
+                              });
+    }
+
+    Interrupt_AddHandler(InterruptType_VCount, benchSpriteMultiplexerBandBegin, -3);
+    Interrupt_AddHandler(InterruptType_VCount, benchSpriteMultiplexerBandEnd, -1);
+
+    // The schedule is picked up at the first vblank, and the band runs in the frame after each one
+    SpriteMultiplexer_Commit();
+    for (int i = 0; i <= BENCH_ITERATIONS; i++)
+    {
+        SystemCall_WaitForVBlank();
+    }
+
+    Interrupt_RemoveHandler(InterruptType_VCount, benchSpriteMultiplexerBandBegin);
+    Interrupt_RemoveHandler(InterruptType_VCount, benchSpriteMultiplexerBandEnd);
+}
+
+static void benchSpriteMultiplexerVBlankBegin(void)
+{
+    Profile_Begin(BenchZoneId_SpriteMultiplexerVBlank);
+}
+
+static void benchSpriteMultiplexerVBlankEnd(void)
+{
+    Profile_End(BenchZoneId_SpriteMultiplexerVBlank);
+}
+
+// Times the VBlank handler copying the schedule of whatever has been added, the same way as the band
+static void benchSpriteMultiplexerVBlank(void)
+{
+    Interrupt_AddHandler(InterruptType_VBlank, benchSpriteMultiplexerVBlankBegin, 0);
+    Interrupt_AddHandler(InterruptType_VBlank, benchSpriteMultiplexerVBlankEnd, 2);
+
+    // The schedule is only copied at a vblank after a commit
+    for (int i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        SpriteMultiplexer_Commit();
+        SystemCall_WaitForVBlank();
+    }
+
+    Interrupt_RemoveHandler(InterruptType_VBlank, benchSpriteMultiplexerVBlankBegin);
+    Interrupt_RemoveHandler(InterruptType_VBlank, benchSpriteMultiplexerVBlankEnd);
+}
+
+static void benchSpriteMultiplexer(void)
+{
+    Sprite_Init();
+    SpriteMultiplexer_Init(0);
+
+    // Spread down the screen, so that most of them have to share slots
+    for (int i = 0; i < 384; i++)
+    {
+        ObjectAttribute_Build(SpriteMultiplexer_GetAttribute(SpriteMultiplexer_Alloc()),
+                              &(struct ObjectAttributeDescriptor){
+                                  .x = (i * 37) % Graphics_ScreenWidth,
+                                  .y = (i * 5) % (Graphics_ScreenHeight - 8),
+                              });
+    }
+
+    for (int i = 0; i < BENCH_ITERATIONS; i++)
+    {
+        Profile_Begin(BenchZoneId_SpriteMultiplexerCommit);
+        SpriteMultiplexer_Commit();
+        Profile_End(BenchZoneId_SpriteMultiplexerCommit);
+    }
+
+    struct SpriteMultiplexerStats stats = SpriteMultiplexer_GetStats();
+    DebugLog_Printf(DebugLogLevel_Info, "BENCH sprite_multiplexer visible=%d dropped=%d bands=%d overflow_lines=%d",
+                    stats.visibleSprites, stats.droppedSprites, stats.bandCount, stats.overflowLines);
+
+    benchSpriteMultiplexerVBlank();
+    benchSpriteMultiplexerBand();
+
+    Interrupt_DisableType(InterruptType_VCount);
+}
+
+int main(void)
+{
+    DebugLog_Init();
+    Profile_Init();
+
+    Interrupt_Init();
+    Interrupt_EnableType(InterruptType_VBlank);
+    Interrupt_Enable();
+
+    for (int i = 0; i < BenchZoneId_Count; i++)
+    {
+        LOSTGBA_UNSAFE(Profile_SetZoneName)(i, benchZoneNames[i]);
+    }
+
+    benchOam();
+    benchSpriteCommit();
+    benchMap();
+    benchLoads();
+    benchObjectAttributes();
+    benchSound();
+    benchBitmap();
+    benchPalette();
+    benchText();
+    benchEntities();
+    benchSpriteMultiplexer();
+
+    Profile_Report();
+    DebugLog_Print(DebugLogLevel_Fatal, "BENCH done");
+
+    while (true)
+    {
+    }
+}
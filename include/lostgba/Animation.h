@@ -0,0 +1,149 @@
+/**
+ * @file Animation.h
+ * @brief Table driven sprite animation
+ *
+ * An AnimationClip is a constant table of frames, each saying which tile (or streamed frame) to show, for how long
+ * and whether to flip it. An Animator plays one clip at a time for one sprite, and Animation_UpdateAll() advances
+ * every initialised animator by one tick. The sprite is only touched when the frame actually changes.
+ *
+ * @code
+ * static const struct AnimationFrame swimFrames[] = {
+ *     {.tile = 0, .duration = 8},
+ *     {.tile = 4, .duration = 8},
+ * };
+ * static const struct AnimationClip swimClip = ANIMATION_CLIP(swimFrames, AnimationLoopMode_Loop);
+ *
+ * struct Animator animator;
+ * Animator_Init(&animator, attr, NULL);
+ * Animator_Play(&animator, &swimClip);
+ *
+ * while (true)
+ * {
+ *     Animation_UpdateAll();
+ *     // ...
+ * }
+ * @endcode
+ *
+ * @defgroup ANIMATION Animation
+ * @{
+ */
+
+#pragma once
+
+#include "GbaTypes.h"
+#include "ObjectAttribute.h"
+#include "SpriteTileStream.h"
+
+/** The maximum number of animators which can be initialised at once */
+#define Animation_MaxAnimators 128
+
+/** Flags for an AnimationFrame */
+enum AnimationFrameFlag
+{
+    /** Flip the sprite horizontally for this frame */
+    AnimationFrameFlag_HFlip = 1 << 0,
+    /** Flip the sprite vertically for this frame */
+    AnimationFrameFlag_VFlip = 1 << 1,
+};
+
+/** A single frame of an AnimationClip */
+struct AnimationFrame
+{
+    /**
+     * The tile to pass to ObjectAttribute_SetTile(), or if the animator has a SpriteTileStream, the frame to pass
+     * to SpriteTileStream_SetFrame()
+     */
+    u16 tile;
+    /** How many ticks this frame is shown for. Must not be 0 */
+    u8 duration;
+    /** A combination of AnimationFrameFlag values */
+    u8 flags;
+    /** Added to the sprite's x position while this frame is shown. See Animator::offsetX */
+    s8 offsetX;
+    /** Added to the sprite's y position while this frame is shown. See Animator::offsetY */
+    s8 offsetY;
+};
+
+/** What happens after the last frame of an AnimationClip */
+enum AnimationLoopMode
+{
+    /** Go back to the first frame */
+    AnimationLoopMode_Loop,
+    /** Stay on the last frame and mark the animator as finished */
+    AnimationLoopMode_Once,
+};
+
+/** A sequence of frames. Make these const so they stay in ROM */
+struct AnimationClip
+{
+    const struct AnimationFrame *frames;
+    u16 frameCount;
+    /** An AnimationLoopMode */
+    u16 loopMode;
+};
+
+/** Builds an AnimationClip from an array of AnimationFrame */
+#define ANIMATION_CLIP(frameArray, mode)                            \
+    {                                                               \
+        .frames = (frameArray),                                     \
+        .frameCount = sizeof(frameArray) / sizeof((frameArray)[0]), \
+        .loopMode = (mode),                                         \
+    }
+
+/**
+ * @brief Plays AnimationClips on a sprite
+ *
+ * Set up with Animator_Init(). Only offsetX and offsetY should be read directly.
+ */
+struct Animator
+{
+    const struct AnimationClip *clip;
+    /** The sprite to update, or NULL to only track the offsets */
+    struct ObjectAttribute *attr;
+    /** If not NULL, frames are shown by streaming them rather than changing the sprite's tile */
+    struct SpriteTileStream *stream;
+    u16 frameIndex;
+    /** Ticks left until the next frame */
+    u8 ticksLeft;
+    bool finished;
+    /** The current frame couldn't be streamed and is shown again on the next update */
+    bool pending;
+    /** The offsetX of the current frame. Add this to the x position of the sprite */
+    s8 offsetX;
+    /** The offsetY of the current frame. Add this to the y position of the sprite */
+    s8 offsetY;
+    /** Where this animator is in the list of animators Animation_UpdateAll() goes through */
+    u8 activeIndex;
+};
+
+/**
+ * @brief Sets up @p animator for @p attr and adds it to the animators updated by Animation_UpdateAll()
+ *
+ * If @p stream isn't NULL, frames are shown with SpriteTileStream_SetFrame() and the tile of @p attr isn't touched.
+ * @p attr can be NULL for an animator which only provides offsets. Nothing is played until Animator_Play().
+ *
+ * Initialising an animator which is already being updated just resets it. Returns false if it isn't already being
+ * updated and Animation_MaxAnimators others are.
+ */
+bool Animator_Init(struct Animator *animator, struct ObjectAttribute *attr, struct SpriteTileStream *stream);
+
+/** Stops Animation_UpdateAll() from updating @p animator. It must be initialised again before being reused */
+void Animator_Remove(struct Animator *animator);
+
+/**
+ * @brief Starts playing @p clip from the first frame, which is shown immediately
+ *
+ * Does nothing if @p clip is already playing, so this can be called every frame with whichever clip should be shown.
+ */
+void Animator_Play(struct Animator *animator, const struct AnimationClip *clip);
+
+/** Whether an AnimationLoopMode_Once clip has reached the end of its last frame */
+static inline bool Animator_IsFinished(const struct Animator *animator)
+{
+    return animator->finished;
+}
+
+/** Advances every initialised animator by one tick. Call this once per frame */
+void Animation_UpdateAll(void);
+
+/** @} */
@@ -100,6 +100,51 @@ enum BackgroundSize
 /** Set the background size for the given background */
 void Background_SetSize(enum BackgroundNumber backgroundNumber, enum BackgroundSize backgroundSize);
 
+/**
+ * @brief Sets the scroll offset of the given (regular) background
+ * @param backgroundNumber The background to scroll
+ * @param x The x coordinate in the map which appears at the left of the screen. Wraps around the size of the map
+ * @param y The y coordinate in the map which appears at the top of the screen. Wraps around the size of the map
+ *
+ * The scroll registers take effect immediately, so to avoid tearing call this during vblank.
+ */
+void Background_SetScroll(enum BackgroundNumber backgroundNumber, int x, int y);
+
+/** The scroll offset for a single scanline. Laid out to match the scroll registers */
+struct BackgroundScrollOffset
+{
+    u16 x; /**< The horizontal scroll offset for this line */
+    u16 y; /**< The vertical scroll offset for this line */
+} LOSTGBA_ALIGN(4);
+
+/** The number of entries in a scroll table. One per scanline */
+#define Background_ScrollTableLength 160
+
+/**
+ * @brief Starts driving the scroll of @p backgroundNumber from a per scanline scroll table
+ *
+ * The offsets are copied into the scroll registers at the start of every hblank by DMA channel 0, so effects like
+ * parallax and waves cost no CPU time per scanline. Only one background can use a scroll table at once.
+ *
+ * The table is double buffered. Fill in the table returned by Background_GetScrollTable() and call
+ * Background_SwapScrollTable() once it is ready. A VBlank handler restarts the table every frame, so call
+ * Interrupt_Init() first and have VBlank interrupts enabled.
+ */
+void Background_EnableScrollTable(enum BackgroundNumber backgroundNumber);
+
+/** Stops using the scroll table and frees up DMA channel 0. The background keeps the offset of the last line drawn */
+void Background_DisableScrollTable(void);
+
+/**
+ * @brief Gets the scroll table which isn't currently on screen, for you to fill in
+ *
+ * Has Background_ScrollTableLength entries, one per scanline.
+ */
+struct BackgroundScrollOffset *Background_GetScrollTable(void);
+
+/** Marks the table from Background_GetScrollTable() as ready, so it is shown from the next frame */
+void Background_SwapScrollTable(void);
+
 /**
  * @brief Set the tile to the given tileId
  * 
@@ -123,4 +168,103 @@ void Background_SetSize(enum BackgroundNumber backgroundNumber, enum BackgroundS
     } while (0)
 /** Unsafe version of Background_SetTile */
 void LOSTGBA_UNSAFE(Background_SetTile)(int screenBaseBlock, enum BackgroundSize backgroundSize, int x, int y, int tileId, bool hflip, bool vflip, int paletteBank);
+
+/**
+ * @brief Builds a single screen entry for use with the bulk screen entry functions below
+ * @param tileId The tile to display
+ * @param hflip Whether the tile should be flipped horizontally
+ * @param vflip Whether the tile should be filpped vertically
+ * @param paletteBank Which palette bank to use
+ */
+static inline u16 Background_MakeScreenEntry(int tileId, bool hflip, bool vflip, int paletteBank)
+{
+    return (tileId & 0x3ff) |
+           (hflip << 10) |
+           (vflip << 11) |
+           (paletteBank << 12);
+}
+
+/**
+ * @brief Sets @p length consecutive tiles in a row to the given screen entries
+ * @param baseBlock The base block that the background has been set to
+ * @param backgroundSize The size of the background
+ * @param x The x location in the tilemap of the first tile
+ * @param y The y location in the tilemap
+ * @param entries The screen entries to use, created with Background_MakeScreenEntry()
+ * @param length The number of entries to write
+ *
+ * The row wraps around to the start if it goes off the right edge of the map. This is much faster than calling
+ * Background_SetTile() for each tile, since it writes 2 entries at a time and only works out which screen block
+ * to use once per screen block rather than once per tile.
+ */
+#define Background_SetRow(baseBlock, backgroundSize, x, y, entries, length)                                 \
+    do                                                                                                      \
+    {                                                                                                       \
+        _Static_assert(0 <= baseBlock && baseBlock <= 31, "Base block must be between 0 and 31 inclusive"); \
+        LOSTGBA_UNSAFE(Background_SetRow)                                                                   \
+        (baseBlock, backgroundSize, x, y, entries, length);                                                 \
+    } while (0)
+/** Unsafe version of Background_SetRow */
+void LOSTGBA_UNSAFE(Background_SetRow)(int screenBaseBlock, enum BackgroundSize backgroundSize, int x, int y, const u16 *entries, int length);
+
+/**
+ * @brief Sets @p length consecutive tiles in a column to the given screen entries
+ *
+ * Same as Background_SetRow() except it goes downwards from (@p x, @p y), wrapping around to the top if it goes off
+ * the bottom of the map.
+ */
+#define Background_SetColumn(baseBlock, backgroundSize, x, y, entries, length)                              \
+    do                                                                                                      \
+    {                                                                                                       \
+        _Static_assert(0 <= baseBlock && baseBlock <= 31, "Base block must be between 0 and 31 inclusive"); \
+        LOSTGBA_UNSAFE(Background_SetColumn)                                                                \
+        (baseBlock, backgroundSize, x, y, entries, length);                                                 \
+    } while (0)
+/** Unsafe version of Background_SetColumn */
+void LOSTGBA_UNSAFE(Background_SetColumn)(int screenBaseBlock, enum BackgroundSize backgroundSize, int x, int y, const u16 *entries, int length);
+
+/**
+ * @brief Sets every tile in a rectangle to the same screen entry
+ * @param baseBlock The base block that the background has been set to
+ * @param backgroundSize The size of the background
+ * @param x The x location in the tilemap of the top left of the rectangle
+ * @param y The y location in the tilemap of the top left of the rectangle
+ * @param width The width of the rectangle in tiles
+ * @param height The height of the rectangle in tiles
+ * @param screenEntry The screen entry to use, created with Background_MakeScreenEntry()
+ *
+ * The rectangle wraps around the edges of the map.
+ */
+#define Background_FillRect(baseBlock, backgroundSize, x, y, width, height, screenEntry)                    \
+    do                                                                                                      \
+    {                                                                                                       \
+        _Static_assert(0 <= baseBlock && baseBlock <= 31, "Base block must be between 0 and 31 inclusive"); \
+        LOSTGBA_UNSAFE(Background_FillRect)                                                                 \
+        (baseBlock, backgroundSize, x, y, width, height, screenEntry);                                      \
+    } while (0)
+/** Unsafe version of Background_FillRect */
+void LOSTGBA_UNSAFE(Background_FillRect)(int screenBaseBlock, enum BackgroundSize backgroundSize, int x, int y, int width, int height, u16 screenEntry);
+
+/**
+ * @brief Copies a rectangle of screen entries into the tilemap
+ * @param baseBlock The base block that the background has been set to
+ * @param backgroundSize The size of the background
+ * @param x The x location in the tilemap of the top left of the rectangle
+ * @param y The y location in the tilemap of the top left of the rectangle
+ * @param width The width of the rectangle in tiles
+ * @param height The height of the rectangle in tiles
+ * @param entries The screen entries to copy, row by row
+ * @param entriesStride The number of entries between the start of each row in @p entries
+ *
+ * The rectangle wraps around the edges of the map.
+ */
+#define Background_CopyRect(baseBlock, backgroundSize, x, y, width, height, entries, entriesStride)         \
+    do                                                                                                      \
+    {                                                                                                       \
+        _Static_assert(0 <= baseBlock && baseBlock <= 31, "Base block must be between 0 and 31 inclusive"); \
+        LOSTGBA_UNSAFE(Background_CopyRect)                                                                 \
+        (baseBlock, backgroundSize, x, y, width, height, entries, entriesStride);                           \
+    } while (0)
+/** Unsafe version of Background_CopyRect */
+void LOSTGBA_UNSAFE(Background_CopyRect)(int screenBaseBlock, enum BackgroundSize backgroundSize, int x, int y, int width, int height, const u16 *entries, int entriesStride);
 /** @} */
\ No newline at end of file
@@ -0,0 +1,108 @@
+/**
+ * @file Bitmap.h
+ * @brief Drawing to the framebuffer in the bitmap graphics modes
+ *
+ * mode | size    | pixels                  | pages
+ * -----|---------|-------------------------|------
+ * 3    | 240x160 | 16 bit BGR555 colours   | 1
+ * 4    | 240x160 | 8 bit background palette indices | 2
+ * 5    | 160x128 | 16 bit BGR555 colours   | 2
+ *
+ * In modes 4 and 5 everything is drawn to the page which isn't being displayed, and Bitmap_Flip() swaps the pages
+ * over at the next vblank. Mode 3 only has one page, so drawing shows up straight away.
+ *
+ * @code
+ * Interrupt_Init();
+ * Interrupt_EnableType(InterruptType_VBlank);
+ * Interrupt_Enable();
+ *
+ * Graphics_SetMode((struct GraphicsSettings){.graphicsMode = GraphicsMode_4, .enableBG2 = true});
+ * Bitmap_Init(GraphicsMode_4);
+ *
+ * while (true)
+ * {
+ *     Bitmap_Clear(0);
+ *     Bitmap_DrawLine(0, 0, 239, 159, 1);
+ *     Bitmap_Flip();
+ *     Bitmap_WaitForFlip();
+ * }
+ * @endcode
+ *
+ * Colours are a background palette index in mode 4 and a BGR555 colour in modes 3 and 5. Everything is clipped to
+ * the screen, and the per row work is done by ARM code in IWRAM using 32 bit stores wherever the alignment
+ * allows. VRAM can't be written a byte at a time, so in mode 4 odd pixels at the ends of rows are read, modified
+ * and written back 16 bits at a time.
+ *
+ * @defgroup BITMAP Bitmap modes
+ * @{
+ */
+
+#pragma once
+
+#include "GbaTypes.h"
+#include "Graphics.h"
+
+/**
+ * @brief Sets up drawing for bitmap mode @p mode (GraphicsMode_3, 4 or 5)
+ *
+ * Call after Graphics_SetMode(), which always displays page 0. Needs Interrupt_Init() to have been called first,
+ * since pages are flipped by a VBlank handler.
+ */
+void Bitmap_Init(enum GraphicsMode mode);
+
+/** The width in pixels of the current bitmap mode */
+int Bitmap_Width(void);
+
+/** The height in pixels of the current bitmap mode */
+int Bitmap_Height(void);
+
+/**
+ * @brief The page which is drawn to. u8 pixels in mode 4 and u16 in modes 3 and 5, Bitmap_Width() per row
+ *
+ * Only write to it 16 or 32 bits at a time.
+ */
+void *Bitmap_GetBackBuffer(void);
+
+/**
+ * @brief Displays everything drawn so far at the next vblank
+ *
+ * Don't draw anything else until the flip has happened (see Bitmap_WaitForFlip()), since until then the back
+ * buffer is the page about to be displayed. Does nothing in mode 3.
+ */
+void Bitmap_Flip(void);
+
+/** Whether Bitmap_Flip() has been called but the vblank it is waiting for hasn't happened yet */
+bool Bitmap_IsFlipPending(void);
+
+/** Halts until any pending flip has happened. Doesn't wait at all if there isn't one */
+void Bitmap_WaitForFlip(void);
+
+/** Fills the whole back buffer with @p colour */
+void Bitmap_Clear(u16 colour);
+
+/** Sets a single pixel. Use the other functions for anything more than a few pixels, they are much faster */
+void Bitmap_SetPixel(int x, int y, u16 colour);
+
+/** Fills @p length pixels of row @p y starting at @p x */
+void Bitmap_FillSpan(int x, int y, int length, u16 colour);
+
+/** Fills a @p width by @p height rectangle with its top left corner at @p x, @p y */
+void Bitmap_FillRect(int x, int y, int width, int height, u16 colour);
+
+/**
+ * @brief Draws a line from @p x0, @p y0 to @p x1, @p y1 inclusive
+ *
+ * The ends can be off screen, but all coordinates must be between -16000 and 16000.
+ */
+void Bitmap_DrawLine(int x0, int y0, int x1, int y1, u16 colour);
+
+/**
+ * @brief Copies a @p width by @p height image to the back buffer with its top left corner at @p x, @p y
+ * @param pixels u8 palette indices in mode 4 and u16 colours in modes 3 and 5. Must be 16 bit aligned
+ * @param stride The number of pixels from the start of one row of @p pixels to the next
+ *
+ * Fastest when each row of @p pixels has the same alignment mod 4 as where it lands in the back buffer.
+ */
+void Bitmap_Blit(int x, int y, const void *pixels, int width, int height, int stride);
+
+/** @} */
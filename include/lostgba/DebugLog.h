@@ -0,0 +1,41 @@
+/**
+ * @file DebugLog.h
+ * @brief Log messages to the emulator's debug output
+ *
+ * Uses mGBA's debug registers. On real hardware (or other emulators) DebugLog_Init() returns false and logging
+ * does nothing.
+ *
+ * @defgroup DEBUG_LOG Debug logging
+ * @{
+ */
+
+#pragma once
+
+#include "GbaTypes.h"
+
+/** How important a log message is */
+enum DebugLogLevel
+{
+    DebugLogLevel_Fatal,   /**< Fatal. mGBA will stop emulation after showing this */
+    DebugLogLevel_Error,   /**< Error */
+    DebugLogLevel_Warning, /**< Warning */
+    DebugLogLevel_Info,    /**< Info */
+    DebugLogLevel_Debug    /**< Debug */
+};
+
+/** The longest message which can be logged in one go, including the null terminator. Longer messages get cut off */
+#define DebugLog_MaxMessageLength 256
+
+/**
+ * @brief Turns on debug logging
+ * @returns Whether debug logging is available (i.e. whether we're running in mGBA)
+ */
+bool DebugLog_Init(void);
+
+/** Logs @p message. Does nothing if DebugLog_Init() hasn't been called or returned false */
+void DebugLog_Print(enum DebugLogLevel level, const char *message);
+
+/** Logs a printf style formatted message. Does nothing if DebugLog_Init() hasn't been called or returned false */
+void DebugLog_Printf(enum DebugLogLevel level, const char *format, ...) __attribute__((format(printf, 2, 3)));
+
+/** @} */
@@ -0,0 +1,120 @@
+/**
+ * @file Dma.h
+ * @brief Direct memory access transfers
+ *
+ * The GBA has 4 DMA channels which copy memory around while the CPU is halted. They are much faster than
+ * copying with the CPU, especially when the code doing the copy is running from ROM.
+ *
+ * channel | Typical use
+ * --------|------------
+ * 0       | Time critical transfers (e.g. HBlank effects). Highest priority. Cannot read from ROM
+ * 1       | Sound FIFO A
+ * 2       | Sound FIFO B
+ * 3       | General purpose copies. Lowest priority. Used by Dma_Copy16() etc.
+ *
+ * Channels 0 - 2 can transfer at most 0x4000 units at once and channel 3 can transfer at most 0x10000 units.
+ *
+ * @defgroup DMA Direct memory access
+ * @{
+ */
+
+#pragma once
+
+#include "GbaTypes.h"
+
+/** The DMA channel to use. Lower numbered channels have priority over higher numbered ones */
+enum DmaChannel
+{
+    DmaChannel_0, /**< DMA channel 0. Can't read from ROM */
+    DmaChannel_1, /**< DMA channel 1 */
+    DmaChannel_2, /**< DMA channel 2 */
+    DmaChannel_3  /**< DMA channel 3. Used by the Dma_Copy* and Dma_Fill* helpers */
+};
+
+/** What happens to the source or destination address after each unit is transferred */
+enum DmaAddressControl
+{
+    /** Move onto the next address */
+    DmaAddressControl_Increment,
+    /** Move onto the previous address */
+    DmaAddressControl_Decrement,
+    /** Keep the same address. Useful for fills (for the source) or FIFOs (for the destination) */
+    DmaAddressControl_Fixed,
+    /** Increment, but reset back to the start when the transfer repeats. Only valid for the destination */
+    DmaAddressControl_IncrementReload
+};
+
+/** The size of each unit transferred */
+enum DmaChunkSize
+{
+    DmaChunkSize_16, /**< Transfer 16 bits at a time */
+    DmaChunkSize_32  /**< Transfer 32 bits at a time */
+};
+
+/** When the transfer should happen */
+enum DmaTiming
+{
+    /** Start the transfer straight away. The CPU is halted until it finishes */
+    DmaTiming_Immediate,
+    /** Start the transfer at the start of the next VBlank */
+    DmaTiming_VBlank,
+    /** Start the transfer at the start of the next HBlank. HBlank transfers do not happen during VBlank */
+    DmaTiming_HBlank,
+    /** Channels 1 and 2: refill the sound FIFOs. Channel 3: video capture */
+    DmaTiming_Special
+};
+
+/**
+ * @brief Full DMA transfer control
+ *
+ * The zero value of this struct is an immediate, incrementing 16 bit copy.
+ */
+struct DmaSettings
+{
+    enum DmaAddressControl destinationControl;
+    enum DmaAddressControl sourceControl;
+    enum DmaChunkSize chunkSize;
+    enum DmaTiming timing;
+    /** Whether the transfer should happen again every time the timing condition is met. Ignored for immediate transfers */
+    bool repeat;
+    /** Whether to fire the InterruptType_Dma* interrupt for this channel once the transfer finishes */
+    bool interruptOnFinish;
+} LOSTGBA_PACKED_ALIGN(4);
+
+/**
+ * @brief Starts a DMA transfer on the given channel
+ * @param channel The channel to use. Any previous transfer on this channel is cancelled
+ * @param source Where to read from
+ * @param destination Where to write to
+ * @param count The number of 16 or 32 bit units to transfer (depending on settings.chunkSize)
+ * @param settings How the transfer should behave
+ *
+ * Both @p source and @p destination must be aligned to the chunk size.
+ */
+void Dma_Start(enum DmaChannel channel, const volatile void *source, volatile void *destination, u32 count, struct DmaSettings settings);
+
+/** Stops any transfer on the given channel. Mainly useful for repeating transfers */
+void Dma_Stop(enum DmaChannel channel);
+
+/** Whether the given channel is still enabled (i.e. waiting to start, transferring or repeating) */
+bool Dma_IsRunning(enum DmaChannel channel);
+
+/** Immediately copies @p count 16 bit values from @p source to @p destination using DMA channel 3 */
+void Dma_Copy16(const void *source, volatile void *destination, u32 count);
+/** Immediately copies @p count 32 bit values from @p source to @p destination using DMA channel 3 */
+void Dma_Copy32(const void *source, volatile void *destination, u32 count);
+
+/**
+ * @brief Immediately copies @p length bytes from @p source to @p destination using DMA channel 3
+ *
+ * Copies as much as possible 32 bits at a time, with a final 16 bit copy if @p length isn't a multiple of 4.
+ * Both pointers must be 4 byte aligned and @p length must be even.
+ */
+void Dma_Copy(const void *source, volatile void *destination, u32 length);
+
+/** Immediately sets @p count 16 bit values at @p destination to @p value using DMA channel 3 */
+void Dma_Fill16(u16 value, volatile void *destination, u32 count);
+/** Immediately sets @p count 32 bit values at @p destination to @p value using DMA channel 3 */
+void Dma_Fill32(u32 value, volatile void *destination, u32 count);
+
+/** @} */
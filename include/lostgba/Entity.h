@@ -0,0 +1,172 @@
+/**
+ * @file Entity.h
+ * @brief Lots of moving sprites, stored as parallel arrays and updated in batches
+ *
+ * Each entity is a position, a velocity, an animation and a sprite (allocated with Sprite_Alloc()). Rather than a
+ * struct per entity, every field lives in its own array and the live entities are packed at the start of them, so
+ * Entity_UpdateAll() is a handful of tight loops straight through memory instead of a function call per entity.
+ *
+ * @code
+ * Sprite_Init();
+ * Entity_Init();
+ *
+ * EntityHandle fish = Entity_Create(Fixed16_FromInt(10), Fixed16_FromInt(20),
+ *                                   &(struct ObjectAttributeDescriptor){.size = ObjectAttributeSize_16});
+ * Entity_SetVelocity(fish, Fixed16_One, 0);
+ * Entity_SetEdgeMode(fish, EntityEdgeMode_Bounce);
+ * Entity_Play(fish, &swimClip);
+ *
+ * while (true)
+ * {
+ *     Entity_UpdateAll();
+ *     Sprite_Commit();
+ *     SystemCall_WaitForVBlank();
+ *     ObjectAttributeBuffer_CopyBufferToMemory();
+ * }
+ * @endcode
+ *
+ * Game code which touches every entity should do the same: loop over the first entityCount elements of entityX,
+ * entityY, entityVelocityX and entityVelocityY directly. Entity_Index() finds where a handle is in those arrays.
+ * Destroying an entity moves the last one into its place, so indices are only good until the next Entity_Destroy().
+ *
+ * The passes run as ARM code from IWRAM.
+ *
+ * @defgroup ENTITY Entities
+ * @{
+ */
+
+#pragma once
+
+#include "GbaTypes.h"
+#include "Animation.h"
+#include "Fixed.h"
+#include "ObjectAttribute.h"
+#include "Sprite.h"
+
+/** The maximum number of entities at once. Each one needs a sprite */
+#define Entity_MaxEntities Sprite_MaxSprites
+
+/** Identifies an entity. Valid from Entity_Create() until it is passed to Entity_Destroy() */
+typedef int EntityHandle;
+
+/** Returned by Entity_Create() when there is no room for another entity */
+#define Entity_InvalidHandle (-1)
+
+/** What happens when an entity reaches the edge of the screen */
+enum EntityEdgeMode
+{
+    /** Nothing, it carries on off screen */
+    EntityEdgeMode_None,
+    /** It stops at the edge, and its velocity towards that edge is set to 0 */
+    EntityEdgeMode_Clamp,
+    /** It bounces off the edge, reversing its velocity towards that edge */
+    EntityEdgeMode_Bounce,
+};
+
+/** The number of live entities, which are the first entityCount elements of the arrays below */
+extern int entityCount;
+
+/** The x position of the top left of each entity, in pixels */
+extern Fixed16 entityX[Entity_MaxEntities];
+/** The y position of the top left of each entity, in pixels */
+extern Fixed16 entityY[Entity_MaxEntities];
+/** How far each entity moves right every Entity_Integrate(), in pixels */
+extern Fixed16 entityVelocityX[Entity_MaxEntities];
+/** How far each entity moves down every Entity_Integrate(), in pixels */
+extern Fixed16 entityVelocityY[Entity_MaxEntities];
+
+/**
+ * @brief The index in the arrays above for each handle
+ *
+ * @internal
+ */
+extern u8 entityIndices[Entity_MaxEntities];
+
+/** Where @p handle is in entityX and the other arrays */
+static inline int Entity_Index(EntityHandle handle)
+{
+    return entityIndices[handle];
+}
+
+/** Destroys every entity. Doesn't free their sprites, so call this straight after Sprite_Init() */
+void Entity_Init(void);
+
+/**
+ * @brief Creates an entity at @p x, @p y with a sprite built from @p sprite
+ *
+ * The position and tileId of @p sprite are ignored. Its tile is used as the first tile of any animation played
+ * with Entity_Play(), and its shape and size give the entity's size for EntityEdgeMode_Clamp and _Bounce. The new
+ * entity isn't moving, has EntityEdgeMode_None and no animation.
+ *
+ * Returns Entity_InvalidHandle if there are already Entity_MaxEntities entities or no sprites are left.
+ */
+EntityHandle Entity_Create(Fixed16 x, Fixed16 y, const struct ObjectAttributeDescriptor *sprite);
+
+/** Destroys @p handle and frees its sprite */
+void Entity_Destroy(EntityHandle handle);
+
+/** The sprite of @p handle, to change anything the entity doesn't control */
+SpriteHandle Entity_GetSprite(EntityHandle handle);
+
+static inline Fixed16 Entity_GetX(EntityHandle handle)
+{
+    return entityX[Entity_Index(handle)];
+}
+
+static inline Fixed16 Entity_GetY(EntityHandle handle)
+{
+    return entityY[Entity_Index(handle)];
+}
+
+static inline void Entity_SetPosition(EntityHandle handle, Fixed16 x, Fixed16 y)
+{
+    int index = Entity_Index(handle);
+    entityX[index] = x;
+    entityY[index] = y;
+}
+
+static inline void Entity_SetVelocity(EntityHandle handle, Fixed16 velocityX, Fixed16 velocityY)
+{
+    int index = Entity_Index(handle);
+    entityVelocityX[index] = velocityX;
+    entityVelocityY[index] = velocityY;
+}
+
+/** Sets what happens when @p handle reaches the edge of the screen */
+void Entity_SetEdgeMode(EntityHandle handle, enum EntityEdgeMode edgeMode);
+
+/**
+ * @brief Sets how far the sprite is drawn from the entity's position, in pixels
+ *
+ * Playing an animation overwrites this with the offsets of each frame, so this is for entities which don't have one
+ * (for example ones animated with an Animator so they can use a SpriteTileStream).
+ */
+void Entity_SetOffset(EntityHandle handle, int offsetX, int offsetY);
+
+/**
+ * @brief Starts playing @p clip on @p handle from the first frame
+ *
+ * Works like Animator_Play(), except frame tiles are added to the tile the entity was created with, so entities
+ * with different graphics can share a clip. Does nothing if @p clip is already playing. Pass NULL to stop.
+ */
+void Entity_Play(EntityHandle handle, const struct AnimationClip *clip);
+
+/** Whether an AnimationLoopMode_Once clip played on @p handle has reached the end of its last frame */
+bool Entity_IsAnimationFinished(EntityHandle handle);
+
+/** Advances every entity's animation by one tick */
+void Entity_Animate(void);
+
+/** Adds every entity's velocity to its position */
+void Entity_Integrate(void);
+
+/** Keeps every entity with an edge mode on screen */
+void Entity_ApplyEdges(void);
+
+/** Writes every entity's position (plus its offset) to its sprite. Call before Sprite_Commit() */
+void Entity_WriteSprites(void);
+
+/** Entity_Animate(), Entity_Integrate(), Entity_ApplyEdges() and Entity_WriteSprites(). Call once per frame */
+void Entity_UpdateAll(void);
+
+/** @} */
@@ -0,0 +1,169 @@
+/**
+ * @file Fixed.h
+ * @brief Fixed point numbers, since the GBA has neither an FPU nor a hardware divider
+ *
+ * Two formats are provided. Fixed8 is 8.8, which matches the affine registers and is small enough to store lots of.
+ * Fixed16 is 16.16 and is the one to use for positions and velocities.
+ *
+ * Multiplying and dividing round to the nearest value. Multiplying two Fixed16 values needs a 64 bit result, which
+ * is a single instruction in ARM mode but a library call in thumb mode, so when updating lots of values at once use
+ * the batch functions at the bottom of this file. They run in ARM mode from IWRAM.
+ *
+ * @code
+ * Fixed16 x = Fixed16_FromInt(10);
+ * Fixed16 speed = Fixed16_One + Fixed16_One / 2; // 1.5 pixels per frame
+ *
+ * x += speed;
+ * ObjectAttribute_SetPos(attr, Fixed16_ToInt(x), 0);
+ * @endcode
+ *
+ * @defgroup FIXED Fixed point maths
+ * @{
+ */
+
+#pragma once
+
+#include "GbaTypes.h"
+
+/** An 8.8 fixed point number */
+typedef s16 Fixed8;
+/** A 16.16 fixed point number */
+typedef s32 Fixed16;
+
+/** 1 as a Fixed8 */
+#define Fixed8_One (1 << 8)
+/** 1 as a Fixed16 */
+#define Fixed16_One (1 << 16)
+
+/** The number of steps in a full turn for the angles used by the trigonometric functions */
+#define Fixed_FullTurn 0x10000
+
+/** Converts @p value to a Fixed8 */
+static inline Fixed8 Fixed8_FromInt(int value)
+{
+    return value << 8;
+}
+
+/** The integer part of @p value, rounded down */
+static inline int Fixed8_ToInt(Fixed8 value)
+{
+    return value >> 8;
+}
+
+/** @p value rounded to the nearest integer */
+static inline int Fixed8_Round(Fixed8 value)
+{
+    return (value + (1 << 7)) >> 8;
+}
+
+/** @p a * @p b rounded to the nearest Fixed8 */
+static inline Fixed8 Fixed8_Mul(Fixed8 a, Fixed8 b)
+{
+    return ((s32)a * b + (1 << 7)) >> 8;
+}
+
+/** @p a / @p b rounded to the nearest Fixed8. @p b must not be 0. Uses the BIOS division routine */
+Fixed8 Fixed8_Div(Fixed8 a, Fixed8 b);
+
+/** Goes from @p a to @p b as @p t goes from 0 to Fixed8_One */
+static inline Fixed8 Fixed8_Lerp(Fixed8 a, Fixed8 b, Fixed8 t)
+{
+    return a + Fixed8_Mul(b - a, t);
+}
+
+/** Converts @p value to a Fixed16 */
+static inline Fixed16 Fixed16_FromInt(int value)
+{
+    return value << 16;
+}
+
+/** Converts @p value to a Fixed16 */
+static inline Fixed16 Fixed16_FromFixed8(Fixed8 value)
+{
+    return (s32)value << 8;
+}
+
+/** Converts @p value to a Fixed8, rounding to the nearest value. The integer part must fit in 8 bits */
+static inline Fixed8 Fixed16_ToFixed8(Fixed16 value)
+{
+    return (value + (1 << 7)) >> 8;
+}
+
+/** The integer part of @p value, rounded down */
+static inline int Fixed16_ToInt(Fixed16 value)
+{
+    return value >> 16;
+}
+
+/** @p value rounded to the nearest integer */
+static inline int Fixed16_Round(Fixed16 value)
+{
+    return (value + (1 << 15)) >> 16;
+}
+
+/** @p a * @p b rounded to the nearest Fixed16 */
+static inline Fixed16 Fixed16_Mul(Fixed16 a, Fixed16 b)
+{
+    return ((s64)a * b + (1 << 15)) >> 16;
+}
+
+/**
+ * @brief @p a / @p b rounded to the nearest Fixed16. @p b must not be 0
+ *
+ * This needs a 64 bit division in software, so is slow. Prefer Fixed16_DivInt() or multiplying by a precalculated
+ * reciprocal where possible.
+ */
+Fixed16 Fixed16_Div(Fixed16 a, Fixed16 b);
+
+/**
+ * @brief @p a / @p divisor rounded to the nearest Fixed16. @p divisor must not be 0
+ *
+ * Divisors between -256 and 256 are looked up in a table of reciprocals and cost a multiply. Larger ones use the
+ * BIOS division routine.
+ */
+Fixed16 Fixed16_DivInt(Fixed16 a, int divisor);
+
+/** 1 / @p value as a Fixed16, from a lookup table. @p value must be between 1 and 256 inclusive */
+Fixed16 Fixed16_ReciprocalInt(int value);
+
+/** Goes from @p a to @p b as @p t goes from 0 to Fixed16_One */
+static inline Fixed16 Fixed16_Lerp(Fixed16 a, Fixed16 b, Fixed16 t)
+{
+    return a + Fixed16_Mul(b - a, t);
+}
+
+/** The sine of @p angle, where Fixed_FullTurn is a full turn. From a 512 entry lookup table */
+Fixed16 Fixed16_Sin(u16 angle);
+/** The cosine of @p angle, where Fixed_FullTurn is a full turn. From a 512 entry lookup table */
+Fixed16 Fixed16_Cos(u16 angle);
+
+/**
+ * @brief The angle of the point (@p x, @p y) from the origin, where Fixed_FullTurn is a full turn
+ *
+ * The angle goes anticlockwise from the positive x axis, with y pointing up. @p x and @p y can be in any fixed point
+ * format as long as they are both the same. Accurate to within about 0.11 degrees.
+ */
+u16 Fixed_ArcTan2(s32 y, s32 x);
+
+/**
+ * @brief Adds @p velocities[i] to @p positions[i] for each of the @p count values
+ *
+ * Runs in ARM mode from IWRAM.
+ */
+void Fixed16_Integrate(Fixed16 *positions, const Fixed16 *velocities, int count);
+
+/**
+ * @brief Adds @p velocities[i] * @p scale to @p positions[i] for each of the @p count values
+ *
+ * Useful for variable time steps. Runs in ARM mode from IWRAM, so each multiply is a single long multiply.
+ */
+void Fixed16_IntegrateScaled(Fixed16 *positions, const Fixed16 *velocities, Fixed16 scale, int count);
+
+/**
+ * @brief Multiplies each of the @p count @p values by @p scale
+ *
+ * Useful for friction or damping. Runs in ARM mode from IWRAM, so each multiply is a single long multiply.
+ */
+void Fixed16_ScaleArray(Fixed16 *values, Fixed16 scale, int count);
+
+/** @} */
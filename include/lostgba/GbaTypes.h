@@ -22,6 +22,8 @@ typedef uint8_t u8;
 typedef uint16_t u16;
 /** Unsigned 32 bit value */
 typedef uint32_t u32;
+/** Unsigned 64 bit value */
+typedef uint64_t u64;
 
 /** Signed 8 bit value */
 typedef int8_t s8;
@@ -29,9 +31,13 @@ typedef int8_t s8;
 typedef int16_t s16;
 /** Signed 32 bit value */
 typedef int32_t s32;
+/** Signed 64 bit value */
+typedef int64_t s64;
 
 /** Volatile unsigned 16 bit value */
 typedef volatile u16 vu16;
+/** Volatile unsigned 32 bit value */
+typedef volatile u32 vu32;
 
 /** 
  * @brief Tells the compiler that this must always be n-byte aligned
@@ -49,4 +55,41 @@ typedef volatile u16 vu16;
 
 #define LOSTGBA_PACKED_ALIGN(n) __attribute__((packed, aligned(n)))
 
+/**
+ * @name Memory placement
+ *
+ * By default code and constant data live in ROM (on a 16 bit bus with wait states), and variables live in IWRAM.
+ * These macros move things elsewhere:
+ *
+ * @code
+ * LOSTGBA_IWRAM_CODE LOSTGBA_ARM_CODE void hotLoop(void) { ... }
+ * LOSTGBA_EWRAM_BSS u16 bigBuffer[64 * 1024];
+ * @endcode
+ *
+ * For whole files of hot code, name the file `*.iwram.c` instead. Those are compiled as ARM code at -O3 and placed
+ * in IWRAM by the linker, without needing any of these on the functions.
+ *
+ * In the host build (see Host.h) they all do nothing.
+ * @{
+ */
+#ifdef LOSTGBA_HOST
+#define LOSTGBA_IWRAM_CODE
+#define LOSTGBA_ARM_CODE
+#define LOSTGBA_IWRAM_DATA
+#define LOSTGBA_EWRAM_DATA
+#define LOSTGBA_EWRAM_BSS
+#else
+/** Puts a function in the 32 bit, zero wait state IWRAM. Also makes calls to it from the same file long calls */
+#define LOSTGBA_IWRAM_CODE __attribute__((section(".iwram"), long_call))
+/** Compiles a function as ARM rather than thumb code. Only worth it for functions in IWRAM */
+#define LOSTGBA_ARM_CODE __attribute__((target("arm")))
+/** Puts an initialised variable in IWRAM. This is where variables go by default anyway */
+#define LOSTGBA_IWRAM_DATA __attribute__((section(".iwram")))
+/** Puts an initialised variable in the 256KB of (slower, 16 bit) EWRAM */
+#define LOSTGBA_EWRAM_DATA __attribute__((section(".ewram")))
+/** Puts a zero initialised variable in EWRAM. Use this for large buffers to keep them out of the 32KB of IWRAM */
+#define LOSTGBA_EWRAM_BSS __attribute__((section(".sbss")))
+#endif
+/** @} */
+
 /** @} */
\ No newline at end of file
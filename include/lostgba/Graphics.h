@@ -20,6 +20,11 @@
  * 0    | reg | reg | reg | reg
  * 1    | reg | reg | aff | -
  * 2    | -   | -   | aff | aff
+ * 3    | -   | -   | bmp | -
+ * 4    | -   | -   | bmp | -
+ * 5    | -   | -   | bmp | -
+ *
+ * The bitmap modes (3 - 5) are drawn to with the functions in Bitmap.h.
  */
 enum GraphicsMode
 {
@@ -51,6 +56,19 @@ void Graphics_SetMode(struct GraphicsSettings graphicsSettings);
 
 /** Controls whether we should trigger vblank interrupts */
 void Graphics_SetVBlankInterrupt(bool enabled);
+/** Controls whether we should trigger hblank interrupts */
+void Graphics_SetHBlankInterrupt(bool enabled);
+/** Controls whether we should trigger vcount interrupts. The line is chosen with Graphics_SetVCountTrigger() */
+void Graphics_SetVCountInterrupt(bool enabled);
+/** Sets which scanline (0 - 227) the vcount interrupt fires at. Lines 160 and above are during vblank */
+void Graphics_SetVCountTrigger(int line);
+
+/**
+ * @brief Chooses which of the two bitmap pages is displayed in modes 4 and 5
+ *
+ * Takes effect straight away, so should be called during vblank to avoid tearing. Bitmap_Flip() does that for you.
+ */
+void Graphics_SetDisplayedFrame(int frame);
 
 #define Graphics_ScreenWidth 240
 #define Graphics_ScreenHeight 160
@@ -0,0 +1,70 @@
+/**
+ * @file Host.h
+ * @brief Running lostgba on a normal computer, for testing and benchmarking
+ *
+ * Build lostgba with `make host` (which defines LOSTGBA_HOST) and every register, VRAM, palette and object attribute
+ * access goes to a simulated memory image instead. The BIOS calls and DMA transfers are done in software, and while
+ * doing so count roughly how many cycles they would have taken on hardware, split by the memory region they touched.
+ *
+ * @code
+ * Host_Reset();
+ * Background_SetRow(30, BackgroundSize_32x32, 0, 0, entries, 32);
+ * const u16 *screenBlock = Host_Address(0x06000000 + 30 * 0x800);
+ *
+ * Host_ResetCycles();
+ * ObjectAttributeBuffer_CopyBufferToMemory();
+ * printf("%u cycles\n", Host_GetTotalCycles());
+ * @endcode
+ *
+ * Only the bulk transfers are counted. Writes the CPU makes directly (e.g. Background_SetTile()) go straight into the
+ * memory image and cost nothing. Source data outside the memory image is counted as ROM, and destinations outside it
+ * as IWRAM, since that's where constant and static data end up on hardware.
+ *
+ * None of this is available in the normal GBA build.
+ *
+ * @defgroup HOST Host backend
+ * @{
+ */
+
+#pragma once
+
+#include "GbaTypes.h"
+#include "Interrupt.h"
+
+/** The memory regions cycles are counted against */
+enum HostMemoryRegion
+{
+    HostMemoryRegion_Bios,    /**< Time spent inside BIOS routines other than their memory accesses */
+    HostMemoryRegion_Rom,     /**< Cartridge ROM, assuming the usual 3/1 wait states */
+    HostMemoryRegion_Ewram,   /**< The 256KB of work RAM on the 16 bit bus */
+    HostMemoryRegion_Iwram,   /**< The 32KB of fast work RAM */
+    HostMemoryRegion_Io,      /**< The IO registers */
+    HostMemoryRegion_Palette, /**< Palette memory */
+    HostMemoryRegion_Vram,    /**< Video memory */
+    HostMemoryRegion_Oam,     /**< Object attribute memory */
+    HostMemoryRegion_Count,
+};
+
+/** Clears all of the simulated memory and the cycle counts */
+void Host_Reset(void);
+
+/** Where GBA address @p address lives in the simulated memory image */
+void *Host_Address(u32 address);
+
+/** The approximate number of cycles spent accessing @p region since the last Host_ResetCycles() */
+u32 Host_GetCycles(enum HostMemoryRegion region);
+
+/** The sum of Host_GetCycles() over every region */
+u32 Host_GetTotalCycles(void);
+
+/** Sets all of the cycle counts back to 0 */
+void Host_ResetCycles(void);
+
+/**
+ * @brief Flags @p interruptType as having happened, and runs the interrupt service routine if it is enabled
+ *
+ * SystemCall_WaitForVBlank() and SystemCall_IntrWait() call this rather than waiting, so main loops keep going.
+ */
+void Host_RaiseInterrupt(enum InterruptType interruptType);
+
+/** @} */
@@ -1,6 +1,11 @@
 /**
  * @file Input.h
  * @brief Handle keyboard input
+ *
+ * Keys are sampled into a history of one entry per sample, and Input_UpdateKeyState() moves the answers on to the
+ * newest one. By default the sample is taken inside Input_UpdateKeyState() itself. After
+ * Input_EnableVBlankSampling() they are taken in the VBlank interrupt instead, so every frame gets exactly one
+ * sample, and presses during frames where the game logic overran VBlank are still seen by the next update.
  * 
  * @defgroup INPUT Input management
  * @{
@@ -25,13 +30,79 @@ enum InputKey
     InputKey_L       /**< L button */
 };
 
-/** Updates the internal key state to ensure that all key press answers are consistent */
+/** The number of samples kept in the key history */
+#define Input_HistoryLength 32
+
+/**
+ * @brief Samples the keys once every VBlank from now on, rather than in Input_UpdateKeyState()
+ *
+ * Registers a VBlank handler, so call Interrupt_Init() first. The VBlank interrupt still needs enabling with
+ * Interrupt_EnableType().
+ */
+void Input_EnableVBlankSampling(void);
+
+/**
+ * @brief Updates the internal key state to ensure that all key press answers are consistent
+ *
+ * Takes in every sample since the last call. With VBlank sampling, that is more than one if the last frame lagged,
+ * and none if this is called twice in one frame.
+ */
 void Input_UpdateKeyState(void);
 
 /** Whether a given key is pressed (at the time the last call to Input_UpdateKeyState was called) */
 bool Input_IsKeyDown(enum InputKey key);
 
-/** Whether a given key is newly pressed since the last time Input_UpdateKeyState was called */
+/** Whether a given key was pressed in any of the samples taken in by the last Input_UpdateKeyState() */
 bool Input_IsNewlyPressed(enum InputKey key);
 
+/** Whether a given key was released in any of the samples taken in by the last Input_UpdateKeyState() */
+bool Input_IsNewlyReleased(enum InputKey key);
+
+/** The keys newly pressed in the last Input_UpdateKeyState(), as a mask of `1 << InputKey` values */
+u16 Input_NewlyPressedKeys(void);
+
+/** The keys newly released in the last Input_UpdateKeyState(), as a mask of `1 << InputKey` values */
+u16 Input_NewlyReleasedKeys(void);
+
+/**
+ * @brief How many samples were missed by the last Input_UpdateKeyState()
+ *
+ * 0 normally, and more than 0 if game logic took longer than a frame. Only meaningful with VBlank sampling.
+ */
+int Input_LaggedFrames(void);
+
+/** How many samples in a row @p key has been held for, or 0 if it isn't held */
+int Input_HeldFrames(enum InputKey key);
+
+/**
+ * @brief Whether @p key was pressed in any of the last @p frames samples
+ *
+ * Useful for buffering a jump pressed just before landing. @p frames is capped at Input_HistoryLength / 2.
+ */
+bool Input_WasPressedWithin(enum InputKey key, int frames);
+
+/**
+ * @brief Auto repeat for menus
+ * @param key The key to check
+ * @param delay How many samples the key must be held before it starts repeating
+ * @param interval How many samples between each repeat after that. 0 or less never repeats
+ *
+ * True when @p key is newly pressed, and then every @p interval samples once it has been held for @p delay. The answer
+ * only changes with Input_UpdateKeyState(), so a repeat is never reported twice when no new samples came in, and a
+ * lagged frame which takes in several samples still reports a repeat that fell on any of them.
+ */
+bool Input_IsRepeating(enum InputKey key, int delay, int interval);
+
+/**
+ * @brief Chooses which keys fire the keypad interrupt
+ * @param keyMask A bit mask of `1 << InputKey` values
+ * @param requireAll If true, all the keys in @p keyMask must be held at once. Otherwise any one of them will do
+ *
+ * The interrupt itself is enabled with Interrupt_EnableType(InterruptType_Keypad)
+ */
+void Input_SetInterruptKeys(u16 keyMask, bool requireAll);
+
+/** Controls whether we should trigger keypad interrupts. Called for you by Interrupt_EnableType() */
+void Input_SetInterruptEnabled(bool enabled);
+
 /** @} */
\ No newline at end of file
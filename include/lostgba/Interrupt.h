@@ -1,7 +1,17 @@
 /**
  * @file Interrupt.h
  * @brief Basic interrupts handling
- * 
+ *
+ * Interrupts are dispatched by a master interrupt service routine which runs in IWRAM as ARM code. It calls each
+ * registered handler whose interrupt has fired, in priority order.
+ *
+ * @code
+ * Interrupt_Init();
+ * Interrupt_AddHandler(InterruptType_HBlank, myHBlankHandler, 0);
+ * Interrupt_EnableType(InterruptType_HBlank);
+ * Interrupt_Enable();
+ * @endcode
+ *
  * @defgroup INTERRUPT Interrupt handling
  * @{
  */
@@ -12,7 +22,7 @@
 
 /**
  * @brief Must be called before doing anything with interrupts.
- * 
+ *
  * Sets up the internal interrupt service routine
  */
 void Interrupt_Init(void);
@@ -22,34 +32,77 @@ void Interrupt_Init(void);
  */
 enum InterruptType
 {
-    InterruptType_VBlank, /**< Triggers on vblank. This will automatically call Graphics_SetVBlankInterrupt(true) for you */
-    InterruptType_HBlank,
-    InterruptType_VCount,
-    InterruptType_Timer0,
-    InterruptType_Timer1,
-    InterruptType_Timer2,
-    InterruptType_Timer3,
-    InterruptType_Dma0,
-    InterruptType_Dma1,
-    InterruptType_Dma2,
-    InterruptType_Dma3,
-    InterruptType_Keypad,
-    InterruptType_Cartridge
+    InterruptType_VBlank,   /**< Triggers on vblank. This will automatically call Graphics_SetVBlankInterrupt(true) for you */
+    InterruptType_HBlank,   /**< Triggers on every hblank. This will automatically call Graphics_SetHBlankInterrupt(true) for you */
+    InterruptType_VCount,   /**< Triggers at the line set by Graphics_SetVCountTrigger(). Automatically calls Graphics_SetVCountInterrupt(true) */
+    InterruptType_Timer0,   /**< Triggers when timer 0 overflows */
+    InterruptType_Timer1,   /**< Triggers when timer 1 overflows */
+    InterruptType_Timer2,   /**< Triggers when timer 2 overflows */
+    InterruptType_Timer3,   /**< Triggers when timer 3 overflows */
+    InterruptType_Serial,   /**< Triggers when a serial transfer finishes */
+    InterruptType_Dma0,     /**< Triggers when a DMA channel 0 transfer started with DmaSettings.interruptOnFinish finishes */
+    InterruptType_Dma1,     /**< Triggers when a DMA channel 1 transfer started with DmaSettings.interruptOnFinish finishes */
+    InterruptType_Dma2,     /**< Triggers when a DMA channel 2 transfer started with DmaSettings.interruptOnFinish finishes */
+    InterruptType_Dma3,     /**< Triggers when a DMA channel 3 transfer started with DmaSettings.interruptOnFinish finishes */
+    InterruptType_Keypad,   /**< Triggers on the key combination set with Input_SetInterruptKeys() */
+    InterruptType_Cartridge /**< Triggers when the cartridge is removed */
 };
 
+/** The number of different interrupt types */
+#define Interrupt_TypeCount 14
+
 /**
  * @brief Enables a specific type of interrupt.
- * 
+ *
  * Check the InterruptType documentation for additional requirements. Note that no interrupts will be fired
  * until you call Interrupt_Enable()
  */
 void Interrupt_EnableType(enum InterruptType interruptType);
 
+/** Stops a specific type of interrupt from firing. The opposite of Interrupt_EnableType() */
+void Interrupt_DisableType(enum InterruptType interruptType);
+
 /**
  * @brief Actually enables interrupts.
- * 
+ *
  * Until this is called, no interrupts will be fired at all
  */
 void Interrupt_Enable(void);
 
-/** @} */
\ No newline at end of file
+/**
+ * @brief A function called when an interrupt fires.
+ *
+ * Handlers run inside the interrupt service routine, so should be kept short. Interrupts have already been
+ * acknowledged by the time the handler is called, so SystemCall_IntrWait() and friends work as expected.
+ */
+typedef void (*InterruptHandler)(void);
+
+/** The maximum number of handlers which can be registered at once */
+#define Interrupt_MaxHandlers 16
+
+/**
+ * @brief Registers a function to be called whenever @p interruptType fires
+ * @param interruptType The interrupt to handle
+ * @param handler The function to call
+ * @param priority Handlers with lower priority values are called first. Handlers with equal priority are called in the order they were added
+ * @returns false if there are already Interrupt_MaxHandlers handlers registered
+ *
+ * Multiple handlers can be registered for the same interrupt type. This does not enable the interrupt, call
+ * Interrupt_EnableType() for that.
+ */
+bool Interrupt_AddHandler(enum InterruptType interruptType, InterruptHandler handler, int priority);
+
+/** Unregisters a handler previously registered with Interrupt_AddHandler() */
+void Interrupt_RemoveHandler(enum InterruptType interruptType, InterruptHandler handler);
+
+/**
+ * @brief Controls whether @p interruptType can interrupt other handlers while they are running
+ *
+ * By default handlers run with all interrupts disabled, so a slow VBlank handler will delay any HBlank or timer
+ * interrupts. Nestable interrupt types are allowed to fire during the handlers of <i>other</i> interrupt types,
+ * which keeps raster effects and audio on time. Costs a few extra cycles per handler call while any nestable
+ * interrupt type is enabled.
+ */
+void Interrupt_SetNestable(enum InterruptType interruptType, bool nestable);
+
+/** @} */
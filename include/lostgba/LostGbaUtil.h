@@ -1,3 +1,16 @@
 #pragma once
 
-#define LOSTGBA_UNSAFE(x) LOSTGBA_UNSAFE__##x
\ No newline at end of file
+#include "GbaTypes.h"
+
+#define LOSTGBA_UNSAFE(x) LOSTGBA_UNSAFE__##x
+
+/**
+ * @brief Returns @p target with the @p length bits starting at @p shift replaced with the bottom bits of @p value
+ *
+ * Meant for use in inline functions, where @p length and @p shift are constants so the masks fold away at compile time.
+ */
+static inline u16 LostGBA_WithBits16(u16 target, u32 value, int length, int shift)
+{
+    u16 mask = ((1 << length) - 1) << shift;
+    return (target & ~mask) | ((value << shift) & mask);
+}
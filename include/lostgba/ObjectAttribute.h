@@ -14,6 +14,7 @@
 #pragma once
 
 #include "GbaTypes.h"
+#include "LostGbaUtil.h"
 
 /**
  * @brief The attribute data for a singular object.
@@ -151,13 +152,58 @@ struct ObjectAttribute
     s16 fill;
 } LOSTGBA_ALIGN(4);
 
+/** The total number of object attributes available. */
+#define ObjectAttributeBuffer_Length 128
+#define ObjectAffineBuffer_Length 32
+
+/**
+ * @brief An in memory buffer of the object attribute memory
+ * 
+ * This buffer is needed because while the screen is rendering, you cannot change the value of anything
+ * in the object attribute memory, so it is best to prepare this during rendering time and when the
+ * screen is ready to be updated, call ObjectAttributeBuffer_CopyBufferToMemory()
+ */
+extern struct ObjectAttribute objectAttributeBuffer[ObjectAttributeBuffer_Length];
+
+/**
+ * @brief Which parts of objectAttributeBuffer need uploading
+ *
+ * One bit per group of 4 object attributes (which is exactly the memory one ObjectAffine is interlaced with).
+ * Use the ObjectAttributeBuffer_MarkDirty() family of functions rather than touching this directly.
+ *
+ * @internal
+ */
+extern u32 objectAttributeBufferDirtyGroups;
+
+/**
+ * @brief Marks @p attr as needing to be uploaded by the next ObjectAttributeBuffer_CopyBufferToMemory()
+ *
+ * Only needed if you write to objectAttributeBuffer without going through the ObjectAttribute_* methods.
+ * Attributes which don't point into objectAttributeBuffer are ignored.
+ */
+static inline void ObjectAttributeBuffer_MarkDirty(const struct ObjectAttribute *attr)
+{
+    u32 index = ((uintptr_t)attr - (uintptr_t)objectAttributeBuffer) / sizeof(struct ObjectAttribute);
+
+    // Attributes which don't live in the buffer (e.g. ones on the stack) don't need tracking
+    if (index < ObjectAttributeBuffer_Length)
+    {
+        objectAttributeBufferDirtyGroups |= 1u << (index / 4);
+    }
+}
+
 /**
  * @brief Sets the position of the sprite
  * @param attr The sprite to change the position of
  * @param x The x coordinate of the top left. Can be out of screen / negative
  * @param y The y coordinate of the top left. Can be out of screen / negative.
  */
-void ObjectAttribute_SetPos(struct ObjectAttribute *attr, int x, int y);
+static inline void ObjectAttribute_SetPos(struct ObjectAttribute *attr, int x, int y)
+{
+    attr->attr0 = LostGBA_WithBits16(attr->attr0, y, 8, 0);
+    attr->attr1 = LostGBA_WithBits16(attr->attr1, x, 9, 0);
+    ObjectAttributeBuffer_MarkDirty(attr);
+}
 
 /** The display mode which controls how the sprite is rendered */
 enum ObjectAttributeDisplayMode
@@ -172,7 +218,11 @@ enum ObjectAttributeDisplayMode
     ObjectAttributeDisplayMode_DoubleRender,
 };
 /** Sets the display mode of the sprite @p attr */
-void ObjectAttribute_SetDisplayMode(struct ObjectAttribute *attr, enum ObjectAttributeDisplayMode displayMode);
+static inline void ObjectAttribute_SetDisplayMode(struct ObjectAttribute *attr, enum ObjectAttributeDisplayMode displayMode)
+{
+    attr->attr0 = LostGBA_WithBits16(attr->attr0, displayMode, 2, 8);
+    ObjectAttributeBuffer_MarkDirty(attr);
+}
 
 /** Flags for special effects */
 enum ObjectAttributeGraphicsMode
@@ -183,10 +233,18 @@ enum ObjectAttributeGraphicsMode
     ObjectAttributeGraphicsMode_Alpha,
 };
 /** Sets the sprite @p attr graphics effect */
-void ObjectAttribute_SetGraphicsMode(struct ObjectAttribute *attr, enum ObjectAttributeGraphicsMode graphicsMode);
+static inline void ObjectAttribute_SetGraphicsMode(struct ObjectAttribute *attr, enum ObjectAttributeGraphicsMode graphicsMode)
+{
+    attr->attr0 = LostGBA_WithBits16(attr->attr0, graphicsMode, 2, 10);
+    ObjectAttributeBuffer_MarkDirty(attr);
+}
 
 /** Set whether @p attr should be displayed with a mosaic effect */
-void ObjectAttribute_SetMosaicEnabled(struct ObjectAttribute *attr, bool enabled);
+static inline void ObjectAttribute_SetMosaicEnabled(struct ObjectAttribute *attr, bool enabled)
+{
+    attr->attr0 = LostGBA_WithBits16(attr->attr0, enabled, 1, 12);
+    ObjectAttributeBuffer_MarkDirty(attr);
+}
 
 /** The colour mode to render the sprite with */
 enum ObjectAttributeColourMode
@@ -197,7 +255,11 @@ enum ObjectAttributeColourMode
     ObjectAttributeColourMode_8PP,
 };
 /** Sets the colour mode for @p attr */
-void ObjectAttribute_SetColourMode(struct ObjectAttribute *attr, enum ObjectAttributeColourMode colourMode);
+static inline void ObjectAttribute_SetColourMode(struct ObjectAttribute *attr, enum ObjectAttributeColourMode colourMode)
+{
+    attr->attr0 = LostGBA_WithBits16(attr->attr0, colourMode, 1, 13);
+    ObjectAttributeBuffer_MarkDirty(attr);
+}
 
 /** The shape of the sprite. This combined with ObjectAttributeSize determines the actual size of the sprite */
 enum ObjectAttributeShape
@@ -210,14 +272,30 @@ enum ObjectAttributeShape
     ObjectAttributeShape_Tall,
 };
 /** Sets the shape for @p attr */
-void ObjectAttribute_SetShape(struct ObjectAttribute *attr, enum ObjectAttributeShape shape);
+static inline void ObjectAttribute_SetShape(struct ObjectAttribute *attr, enum ObjectAttributeShape shape)
+{
+    attr->attr0 = LostGBA_WithBits16(attr->attr0, shape, 2, 14);
+    ObjectAttributeBuffer_MarkDirty(attr);
+}
 
 /** Sets the index of the ObjectAffine used for this sprite. Only valid if ObjectAttributeDisplayMode is ObjectAttributeDisplayMode_Affine or ObjectAttributeDisplayMode_DoubleRender */
-void ObjectAttribute_SetAffineIndex(struct ObjectAttribute *attr, u16 affineIndex);
+static inline void ObjectAttribute_SetAffineIndex(struct ObjectAttribute *attr, u16 affineIndex)
+{
+    attr->attr1 = LostGBA_WithBits16(attr->attr1, affineIndex, 5, 9);
+    ObjectAttributeBuffer_MarkDirty(attr);
+}
 /** Sets whether the sprite should be horizontally flipped. Only valid if ObjectAttributeDisplayMode is ObjectAttributeDisplayMode_Normal or ObjectAttributeDisplayMode_Hidden */
-void ObjectAttribute_SetHFlip(struct ObjectAttribute *attr, bool hflip);
+static inline void ObjectAttribute_SetHFlip(struct ObjectAttribute *attr, bool hflip)
+{
+    attr->attr1 = LostGBA_WithBits16(attr->attr1, hflip, 1, 12);
+    ObjectAttributeBuffer_MarkDirty(attr);
+}
 /** Sets whether the sprite should be vertically flipped. Only valid if ObjectAttributeDisplayMode is ObjectAttributeDisplayMode_Normal or ObjectAttributeDisplayMode_Hidden */
-void ObjectAttribute_SetVFlip(struct ObjectAttribute *attr, bool vflip);
+static inline void ObjectAttribute_SetVFlip(struct ObjectAttribute *attr, bool vflip)
+{
+    attr->attr1 = LostGBA_WithBits16(attr->attr1, vflip, 1, 13);
+    ObjectAttributeBuffer_MarkDirty(attr);
+}
 
 /** The 'size' of the sprite. See the definition of ObjectAttributeShape to understand the way this interacts with that field */
 enum ObjectAttributeSize
@@ -232,9 +310,17 @@ enum ObjectAttributeSize
     ObjectAttributeSize_64,
 };
 /** Sets the 'size' of the sprite @p attr. Find the interaction between this and ObjectAttributeShape in the ObjectAttributeShape documentation */
-void ObjectAttribute_SetSize(struct ObjectAttribute *attr, enum ObjectAttributeSize size);
+static inline void ObjectAttribute_SetSize(struct ObjectAttribute *attr, enum ObjectAttributeSize size)
+{
+    attr->attr1 = LostGBA_WithBits16(attr->attr1, size, 2, 14);
+    ObjectAttributeBuffer_MarkDirty(attr);
+}
 /** Sets the desired tile of this sprite */
-void ObjectAttribute_SetTile(struct ObjectAttribute *attr, u32 tileId);
+static inline void ObjectAttribute_SetTile(struct ObjectAttribute *attr, u32 tileId)
+{
+    attr->attr2 = LostGBA_WithBits16(attr->attr2, tileId, 10, 0);
+    ObjectAttributeBuffer_MarkDirty(attr);
+}
 /**
  * @brief Sets the render priority for this sprite.
  * 
@@ -242,14 +328,100 @@ void ObjectAttribute_SetTile(struct ObjectAttribute *attr, u32 tileId);
  *   Sprites cover backgrounds with the same priority and for sprites with the same priority, the ones which
  *   appear later in the object attribute list are draw first. Change with ObjectAttribute_SetPriority()
  */
-void ObjectAttribute_SetPriority(struct ObjectAttribute *attr, u16 priority);
+static inline void ObjectAttribute_SetPriority(struct ObjectAttribute *attr, u16 priority)
+{
+    attr->attr2 = LostGBA_WithBits16(attr->attr2, priority, 2, 10);
+    ObjectAttributeBuffer_MarkDirty(attr);
+}
 /**
  * @brief Choose which palette bank this sprite should use
  * 
  * This is only used if the sprite is rendered in 16 colour mode, otherwise the sprite colour palette is used.
  */
-void ObjectAttribute_SetPaletteBank(struct ObjectAttribute *attr, u16 paletteBank);
+static inline void ObjectAttribute_SetPaletteBank(struct ObjectAttribute *attr, u16 paletteBank)
+{
+    attr->attr2 = LostGBA_WithBits16(attr->attr2, paletteBank, 4, 12);
+    ObjectAttributeBuffer_MarkDirty(attr);
+}
 
+/**
+ * @brief Everything about a sprite in one place, for use with ObjectAttribute_Build()
+ *
+ * The zero value of this struct is a visible 8x8 sprite at (0, 0) showing tile 0.
+ */
+struct ObjectAttributeDescriptor
+{
+    /** The x coordinate of the top left. Can be out of screen / negative */
+    int x;
+    /** The y coordinate of the top left. Can be out of screen / negative */
+    int y;
+    enum ObjectAttributeDisplayMode displayMode;
+    enum ObjectAttributeGraphicsMode graphicsMode;
+    bool mosaicEnabled;
+    enum ObjectAttributeColourMode colourMode;
+    enum ObjectAttributeShape shape;
+    enum ObjectAttributeSize size;
+    /** Only used if displayMode is ObjectAttributeDisplayMode_Affine or ObjectAttributeDisplayMode_DoubleRender */
+    u16 affineIndex;
+    /** Ignored if displayMode is ObjectAttributeDisplayMode_Affine or ObjectAttributeDisplayMode_DoubleRender */
+    bool hflip;
+    /** Ignored if displayMode is ObjectAttributeDisplayMode_Affine or ObjectAttributeDisplayMode_DoubleRender */
+    bool vflip;
+    u32 tileId;
+    u16 priority;
+    u16 paletteBank;
+};
+
+/**
+ * @brief Sets every attribute of @p attr at once
+ *
+ * Much cheaper than calling each of the ObjectAttribute_Set* methods in turn, since the three attributes are built up
+ * in registers and written with two 32 bit stores. Pass a pointer to a compound literal and the whole thing mostly
+ * folds away at compile time:
+ *
+ * @code
+ * ObjectAttribute_Build(attr, &(struct ObjectAttributeDescriptor){
+ *     .x = 10,
+ *     .y = 20,
+ *     .size = ObjectAttributeSize_16,
+ * });
+ * @endcode
+ *
+ * The affine data interlaced with @p attr is left untouched.
+ */
+static inline void ObjectAttribute_Build(struct ObjectAttribute *attr, const struct ObjectAttributeDescriptor *descriptor)
+{
+    bool affine = descriptor->displayMode == ObjectAttributeDisplayMode_Affine ||
+                  descriptor->displayMode == ObjectAttributeDisplayMode_DoubleRender;
+
+    u32 attr0 = (descriptor->y & 0xff) |
+                (descriptor->displayMode << 8) |
+                (descriptor->graphicsMode << 10) |
+                (descriptor->mosaicEnabled << 12) |
+                (descriptor->colourMode << 13) |
+                (descriptor->shape << 14);
+    u32 attr1 = (descriptor->x & 0x1ff) |
+                (affine ? (descriptor->affineIndex & 0x1f) << 9 : (descriptor->hflip << 12) | (descriptor->vflip << 13)) |
+                (descriptor->size << 14);
+    u32 attr2 = (descriptor->tileId & 0x3ff) |
+                ((descriptor->priority & 0x3) << 10) |
+                ((descriptor->paletteBank & 0xf) << 12);
+
+    u32 *words = (u32 *)attr;
+    words[0] = attr0 | (attr1 << 16);
+    words[1] = attr2 | ((u32)(u16)attr->fill << 16);
+
+    ObjectAttributeBuffer_MarkDirty(attr);
+}
+
+/**
+ * @brief The affine matrix for affine sprites
+ *
+ * pa, pb, pc and pd are 8.8 fixed point and map screen space to texture space, so a matrix which doubles the
+ * size of a sprite has 0x80 on the diagonal. Set these with the ObjectAffine_* methods.
+ *
+ * The ObjectAffine memory is interlaced with the ObjectAttribute memory, so the fill fields <b>must not</b> be touched.
+ */
 struct ObjectAffine
 {
     u16 fill0[3];
@@ -262,24 +434,85 @@ struct ObjectAffine
     s16 pd;
 } LOSTGBA_ALIGN(4);
 
-/** The total number of object attributes available. */
-#define ObjectAttributeBuffer_Length 128
-#define ObjectAffineBuffer_Length 32
+/** The affine matrices, interlaced with objectAttributeBuffer */
+extern struct ObjectAffine *objectAffineBuffer;
+
+/** The number of steps in a full turn for the angles taken by the ObjectAffine_* methods */
+#define ObjectAffine_FullTurn 0x10000
 
 /**
- * @brief An in memory buffer of the object attribute memory
- * 
- * This buffer is needed because while the screen is rendering, you cannot change the value of anything
- * in the object attribute memory, so it is best to prepare this during rendering time and when the
- * screen is ready to be updated, call ObjectAttributeBuffer_CopyBufferToMemory()
+ * @brief A rotation and scale, for use with ObjectAffine_SetRotationScale() and ObjectAffineBuffer_SetRotationScales()
+ *
+ * The zero value of this struct is not very useful (it scales the sprite up infinitely). Use 0x100 for both scales
+ * for a sprite which is only rotated.
  */
-extern struct ObjectAttribute objectAttributeBuffer[ObjectAttributeBuffer_Length];
-extern struct ObjectAffine *objectAffineBuffer;
+struct ObjectAffineTransform
+{
+    /** Anticlockwise rotation, where ObjectAffine_FullTurn is one full turn */
+    u16 angle;
+    /** Inverse horizontal scale in 8.8 fixed point. 0x100 is normal size, 0x80 doubles the width, 0x200 halves it */
+    s16 scaleX;
+    /** Inverse vertical scale in 8.8 fixed point. 0x100 is normal size, 0x80 doubles the height, 0x200 halves it */
+    s16 scaleY;
+};
+
+/** Sets objectAffineBuffer[@p affineIndex] to the identity matrix */
+#define ObjectAffine_SetIdentity(affineIndex)                                                                     \
+    do                                                                                                            \
+    {                                                                                                             \
+        _Static_assert(0 <= affineIndex && affineIndex <= 31, "Affine index must be between 0 and 31 inclusive"); \
+        LOSTGBA_UNSAFE(ObjectAffine_SetIdentity)                                                                  \
+        (affineIndex);                                                                                            \
+    } while (0)
+/** Unsafe version of ObjectAffine_SetIdentity */
+void LOSTGBA_UNSAFE(ObjectAffine_SetIdentity)(int affineIndex);
+
+/**
+ * @brief Sets objectAffineBuffer[@p affineIndex] to rotate by @p angle and scale by @p scaleX and @p scaleY
+ *
+ * See ObjectAffineTransform for the meaning of the arguments. The sine and cosine come from a 512 entry lookup
+ * table in ROM and the whole thing is a handful of multiplies, so this is cheap enough to call for every affine
+ * sprite every frame.
+ */
+#define ObjectAffine_SetRotationScale(affineIndex, angle, scaleX, scaleY)                                         \
+    do                                                                                                            \
+    {                                                                                                             \
+        _Static_assert(0 <= affineIndex && affineIndex <= 31, "Affine index must be between 0 and 31 inclusive"); \
+        LOSTGBA_UNSAFE(ObjectAffine_SetRotationScale)                                                             \
+        (affineIndex, angle, scaleX, scaleY);                                                                     \
+    } while (0)
+/** Unsafe version of ObjectAffine_SetRotationScale */
+void LOSTGBA_UNSAFE(ObjectAffine_SetRotationScale)(int affineIndex, u16 angle, s16 scaleX, s16 scaleY);
+
+/**
+ * @brief Sets @p count consecutive affine matrices starting at objectAffineBuffer[@p firstAffineIndex]
+ *
+ * Equivalent to calling ObjectAffine_SetRotationScale() for each entry of @p transforms, but runs as a single ARM
+ * routine in IWRAM so costs far less per matrix. Matrices past the last of the 32 available are ignored.
+ */
+void ObjectAffineBuffer_SetRotationScales(int firstAffineIndex, const struct ObjectAffineTransform *transforms, int count);
 
 /** 
  * Copies the contents of objectAttributeBuffer (and objectAffineBuffer) to the object attribute memory.
- * Probably want to call this every frame
+ * Probably want to call this every frame.
+ *
+ * Only the parts of the buffer which have changed since the last copy are uploaded, so this does nothing at all
+ * on frames where no sprites were touched. Changes made through the ObjectAttribute_* methods are tracked
+ * automatically, anything else needs to be marked with ObjectAttributeBuffer_MarkDirty() or
+ * ObjectAffineBuffer_MarkDirty().
  */
 void ObjectAttributeBuffer_CopyBufferToMemory(void);
 
+/** Marks objectAffineBuffer[@p affineIndex] as needing to be uploaded by the next ObjectAttributeBuffer_CopyBufferToMemory() */
+static inline void ObjectAffineBuffer_MarkDirty(int affineIndex)
+{
+    objectAttributeBufferDirtyGroups |= 1u << affineIndex;
+}
+
+/** Forces the next ObjectAttributeBuffer_CopyBufferToMemory() to upload the entire buffer */
+static inline void ObjectAttributeBuffer_MarkAllDirty(void)
+{
+    objectAttributeBufferDirtyGroups = ~0u;
+}
+
 /** @} */
\ No newline at end of file
@@ -0,0 +1,140 @@
+/**
+ * @file Palette.h
+ * @brief Shadow palettes with fades, blends and tints
+ *
+ * Both palettes (background then sprite, 512 colours in total) are kept in two copies in RAM. The <i>base</i>
+ * palette holds the colours as loaded, and paletteBuffer holds what should be on screen, which is the base palette
+ * with any colour effects applied. Effects always start from the base colours, so fading to black and back again
+ * doesn't lose anything.
+ *
+ * Palette memory is split into 32 banks of 16 colours (the sub-palettes of 4bpp tiles and sprites). Every
+ * function which changes paletteBuffer marks the banks it touched as dirty, and PaletteBuffer_CopyBufferToMemory()
+ * uploads only the dirty ones. Call it during vblank, like ObjectAttributeBuffer_CopyBufferToMemory().
+ *
+ * Functions which work on several banks at once take a mask with one bit per bank: bits 0 - 15 are the background
+ * banks and bits 16 - 31 the sprite banks. See Palette_BankMask().
+ *
+ * @code
+ * Palette_LoadCompressed(PaletteType_Background, tilemapPal);
+ * Palette_Fade(Palette_AllBanks, Palette_Black, Palette_MaxAmount);
+ *
+ * for (int amount = Palette_MaxAmount; amount >= 0; amount--)
+ * {
+ *     Palette_Fade(Palette_AllBanks, Palette_Black, amount);
+ *     SystemCall_WaitForVBlank();
+ *     PaletteBuffer_CopyBufferToMemory();
+ * }
+ * @endcode
+ *
+ * The effects are ARM code running from IWRAM, and work on 2 colours at a time packed into a 32 bit word.
+ *
+ * @defgroup PALETTE Palettes
+ * @{
+ */
+
+#pragma once
+
+#include "GbaTypes.h"
+#include "TileMap.h"
+
+/** Which of the two palettes */
+enum PaletteType
+{
+    PaletteType_Background, /**< The background palette, at 0x05000000 */
+    PaletteType_Sprite      /**< The sprite palette, at 0x05000200 */
+};
+
+/** The number of colours in a bank */
+#define Palette_BankLength 16
+/** The number of colours in both palettes together */
+#define Palette_Length (2 * TileMap_PaletteLength)
+
+/** A mask of every background bank */
+#define Palette_BackgroundBanks 0x0000ffffu
+/** A mask of every sprite bank */
+#define Palette_SpriteBanks 0xffff0000u
+/** A mask of every bank */
+#define Palette_AllBanks 0xffffffffu
+
+/** The amount which takes an effect all the way. Amounts go from 0 (no effect) to this */
+#define Palette_MaxAmount 32
+
+/** Makes a BGR555 colour from 5 bit components */
+static inline u16 Palette_MakeColour(int red, int green, int blue)
+{
+    return (red & 31) | ((green & 31) << 5) | ((blue & 31) << 10);
+}
+
+#define Palette_Black 0x0000
+#define Palette_White 0x7fff
+
+/** The mask bit for @p bank (0 - 15) of @p type */
+static inline u32 Palette_BankMask(enum PaletteType type, int bank)
+{
+    return 1u << (type * (TileMap_PaletteLength / Palette_BankLength) + bank);
+}
+
+/**
+ * @brief What should be in palette memory: the background palette followed by the sprite palette
+ *
+ * Written by the functions below. If you write to it directly, call PaletteBuffer_MarkDirty() afterwards.
+ */
+extern u16 paletteBuffer[Palette_Length];
+
+/**
+ * @brief Which banks of paletteBuffer need uploading
+ *
+ * @internal
+ */
+extern u32 paletteBufferDirtyBanks;
+
+/** Marks the banks in @p banks as needing to be uploaded by the next PaletteBuffer_CopyBufferToMemory() */
+static inline void PaletteBuffer_MarkDirty(u32 banks)
+{
+    paletteBufferDirtyBanks |= banks;
+}
+
+/** Uploads every dirty bank to palette memory. Call during vblank */
+void PaletteBuffer_CopyBufferToMemory(void);
+
+/**
+ * @brief Sets @p count base colours starting at @p firstColour
+ *
+ * Also copies them to paletteBuffer, replacing any effect on those banks.
+ */
+void Palette_Load(enum PaletteType type, int firstColour, const u16 *colours, int count);
+
+/** Same as Palette_Load() for the whole of a compressed palette (as output by grit with -pz) */
+void Palette_LoadCompressed(enum PaletteType type, const void *compressedColours);
+
+/** Sets a single base colour, and the same colour in paletteBuffer */
+void Palette_SetColour(enum PaletteType type, int index, u16 colour);
+
+/** The base colour at @p index, without any effects */
+u16 Palette_GetColour(enum PaletteType type, int index);
+
+/** Removes any effects from @p banks, setting them back to the base colours */
+void Palette_Restore(u32 banks);
+
+/**
+ * @brief Fades @p banks towards @p colour
+ * @param amount 0 for the base colours, Palette_MaxAmount for all @p colour
+ */
+void Palette_Fade(u32 banks, u16 colour, int amount);
+
+/**
+ * @brief Cross fades @p banks towards another palette
+ * @param target Palette_Length colours, laid out like paletteBuffer. Must be 4 byte aligned
+ * @param amount 0 for the base colours, Palette_MaxAmount for all @p target
+ */
+void Palette_Blend(u32 banks, const u16 *target, int amount);
+
+/**
+ * @brief Multiplies the colours in @p banks by @p colour
+ *
+ * Each component is scaled by the matching component of @p colour, so Palette_White leaves them alone and a red
+ * tint removes all the green and blue.
+ */
+void Palette_Tint(u32 banks, u16 colour);
+
+/** @} */
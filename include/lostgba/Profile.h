@@ -0,0 +1,108 @@
+/**
+ * @file Profile.h
+ * @brief Cycle accurate profiling of named zones
+ *
+ * Uses timers 2 and 3 cascaded together as a free running 32 bit cycle counter. Wrap the code you want to measure
+ * in Profile_Begin() / Profile_End() with the same zone id, and the min / max / average number of cycles it took
+ * is recorded across frames.
+ *
+ * @code
+ * Profile_Init();
+ * Profile_SetZoneName(0, "tilemap");
+ *
+ * Profile_Begin(0);
+ * updateTilemapEntries();
+ * Profile_End(0);
+ * @endcode
+ *
+ * The results live in profileZones, which can be inspected in a debugger, or written to the emulator's debug log
+ * with Profile_Report().
+ *
+ * @defgroup PROFILE Profiling
+ * @{
+ */
+
+#pragma once
+
+#include "GbaTypes.h"
+#include "LostGbaUtil.h"
+
+/** The number of zones available. Zone ids go from 0 to Profile_MaxZones - 1 */
+#define Profile_MaxZones 32
+
+/** The measurements for a single zone */
+struct ProfileZone
+{
+    /** Set with Profile_SetZoneName(). Can be NULL */
+    const char *name;
+    /** The number of times Profile_End() has been called for this zone */
+    u32 count;
+    /** The fewest cycles taken between Profile_Begin() and Profile_End() */
+    u32 minCycles;
+    /** The most cycles taken between Profile_Begin() and Profile_End() */
+    u32 maxCycles;
+    /** The total number of cycles across every measurement. Divide by count for the average */
+    u64 totalCycles;
+    /** @internal The cycle count at the last Profile_Begin() */
+    u32 startCycles;
+};
+
+/** The results of profiling so far. Read these from a debugger or use Profile_Report() */
+extern struct ProfileZone profileZones[Profile_MaxZones];
+
+/** Starts timers 2 and 3 and resets all the zones. Must be called before anything else in this module */
+void Profile_Init(void);
+
+/**
+ * @brief Gives zone @p zone a name for use in Profile_Report(). @p name must stay valid
+ *
+ * Like Profile_Begin() and Profile_End(), this static asserts that @p zone is a valid zone id. Use the unsafe version
+ * for zone ids which aren't constants (but check them somewhere else).
+ */
+#define Profile_SetZoneName(zone, name)                                                                          \
+    do                                                                                                           \
+    {                                                                                                            \
+        _Static_assert(0 <= zone && zone < Profile_MaxZones, "Zone must be between 0 and Profile_MaxZones - 1"); \
+        LOSTGBA_UNSAFE(Profile_SetZoneName)                                                                      \
+        (zone, name);                                                                                            \
+    } while (0)
+/** Unsafe version of Profile_SetZoneName */
+void LOSTGBA_UNSAFE(Profile_SetZoneName)(int zone, const char *name);
+
+/** Clears the measurements of every zone (but keeps the names) */
+void Profile_Reset(void);
+
+/** The number of cycles since Profile_Init() was called. Wraps around every 256 seconds */
+u32 Profile_Cycles(void);
+
+/** Starts measuring @p zone */
+#define Profile_Begin(zone)                                                                                      \
+    do                                                                                                           \
+    {                                                                                                            \
+        _Static_assert(0 <= zone && zone < Profile_MaxZones, "Zone must be between 0 and Profile_MaxZones - 1"); \
+        LOSTGBA_UNSAFE(Profile_Begin)                                                                            \
+        (zone);                                                                                                  \
+    } while (0)
+/** Unsafe version of Profile_Begin */
+void LOSTGBA_UNSAFE(Profile_Begin)(int zone);
+
+/** Stops measuring @p zone and records how many cycles it took since the matching Profile_Begin() */
+#define Profile_End(zone)                                                                                        \
+    do                                                                                                           \
+    {                                                                                                            \
+        _Static_assert(0 <= zone && zone < Profile_MaxZones, "Zone must be between 0 and Profile_MaxZones - 1"); \
+        LOSTGBA_UNSAFE(Profile_End)                                                                              \
+        (zone);                                                                                                  \
+    } while (0)
+/** Unsafe version of Profile_End */
+void LOSTGBA_UNSAFE(Profile_End)(int zone);
+
+/**
+ * @brief Writes every zone which has been measured to the debug log
+ *
+ * Each zone gets one line of the form `PROFILE name=<name> count=<n> min=<cycles> max=<cycles> avg=<cycles>`.
+ * Call DebugLog_Init() first.
+ */
+void Profile_Report(void);
+
+/** @} */
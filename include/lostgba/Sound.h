@@ -0,0 +1,133 @@
+/**
+ * @file Sound.h
+ * @brief Software mixed PCM sound through the DirectSound FIFOs
+ *
+ * Up to Sound_ChannelCount signed 8 bit samples play at once, each with its own volume, pan and pitch. They are
+ * mixed in software into a stereo pair of buffers once per frame, and DirectSound A (left) and B (right) play
+ * those buffers back.
+ *
+ * Timer 0 clocks both FIFOs at Sound_MixRate, and DMA channels 1 and 2 refill them. Exactly
+ * Sound_SamplesPerFrame samples are played each frame, so the buffers are double buffered in step with the
+ * display: a VBlank handler points the DMA at the buffer mixed during the previous frame, and Sound_Mix()
+ * fills the other one.
+ *
+ * @code
+ * Interrupt_Init();
+ * Sound_Init();
+ * Interrupt_EnableType(InterruptType_VBlank);
+ * Interrupt_Enable();
+ *
+ * Sound_Play(&splashSample, Sound_MaxVolume, 0);
+ *
+ * while (true)
+ * {
+ *     SystemCall_WaitForVBlank();
+ *     Sound_Mix();
+ *     ...
+ * }
+ * @endcode
+ *
+ * The cost of Sound_Mix() only depends on how many channels are playing, and there are never more than
+ * Sound_ChannelCount of those, because playing a new sound when every channel is busy replaces the oldest one.
+ * So however many sounds get triggered, mixing never takes more than the time to mix Sound_ChannelCount channels
+ * (see the sound_mix benchmark in bench/Bench.c).
+ *
+ * @defgroup SOUND Sound
+ * @{
+ */
+
+#pragma once
+
+#include "GbaTypes.h"
+#include "Fixed.h"
+
+/** The number of sounds which can play at once */
+#define Sound_ChannelCount 8
+
+/** The playback rate in Hz. Chosen so that a whole number of samples play every frame */
+#define Sound_MixRate 18157
+
+/** The number of samples played per frame (280896 cycles per frame / 924 cycles per sample) */
+#define Sound_SamplesPerFrame 304
+
+/** The loudest volume a channel can have */
+#define Sound_MaxVolume 64
+
+/** The pan for a sound only coming out of the left speaker. Sound_MaxPan is only the right, and 0 is both */
+#define Sound_MinPan (-64)
+/** The pan for a sound only coming out of the right speaker */
+#define Sound_MaxPan 64
+
+/** The value of SoundSample.loopStart for samples which play once and then stop */
+#define Sound_NoLoop 0xffffffffu
+
+/** Signed 8 bit PCM data and how to play it */
+struct SoundSample
+{
+    /** The sample data. Must stay valid while the sample is playing */
+    const s8 *data;
+    /** The number of samples in data. Must be less than 2^20 (about a minute at Sound_MixRate) */
+    u32 length;
+    /** Where to go back to when the end is reached, or Sound_NoLoop to stop at the end */
+    u32 loopStart;
+    /** The rate the sample was recorded at in Hz. This is the rate it plays back at with a pitch of 1 */
+    u32 rate;
+};
+
+/**
+ * @brief Identifies a sound which was started with Sound_Play()
+ *
+ * Handles stay unique after their sound finishes or is replaced, so functions given the handle of a sound which
+ * has stopped do nothing.
+ */
+typedef u32 SoundHandle;
+
+/** Never returned by Sound_Play() */
+#define Sound_InvalidHandle 0u
+
+/**
+ * @brief Starts up the sound hardware, timer 0 and DMA channels 1 and 2
+ *
+ * Needs Interrupt_Init() to have been called first, and InterruptType_VBlank to be enabled for the buffers to
+ * be swapped.
+ */
+void Sound_Init(void);
+
+/**
+ * @brief Starts playing a sample on a free channel
+ * @param sample The sample to play. Must stay valid while it is playing
+ * @param volume 0 (silent) to Sound_MaxVolume
+ * @param pan Sound_MinPan (left) to Sound_MaxPan (right)
+ * @returns A handle to change or stop the sound with
+ *
+ * If every channel is already playing, the sound which started longest ago is stopped to make room.
+ */
+SoundHandle Sound_Play(const struct SoundSample *sample, int volume, int pan);
+
+/** Stops @p handle from playing */
+void Sound_Stop(SoundHandle handle);
+
+/** Whether @p handle is still playing. One shot sounds stop on their own once they reach the end */
+bool Sound_IsPlaying(SoundHandle handle);
+
+/** Changes the volume of @p handle, from 0 to Sound_MaxVolume */
+void Sound_SetVolume(SoundHandle handle, int volume);
+
+/** Changes the pan of @p handle, from Sound_MinPan to Sound_MaxPan */
+void Sound_SetPan(SoundHandle handle, int pan);
+
+/** Changes how fast @p handle plays. Fixed16_One plays at the sample's own rate, 2 an octave higher etc. */
+void Sound_SetPitch(SoundHandle handle, Fixed16 pitch);
+
+/** Stops every sound */
+void Sound_StopAll(void);
+
+/**
+ * @brief Mixes the next frame of sound
+ *
+ * Call once per frame, some time after the VBlank. Runs from IWRAM as ARM code. If a frame is missed, the
+ * previous frame of sound plays again.
+ */
+void Sound_Mix(void);
+
+/** @} */
@@ -0,0 +1,81 @@
+/**
+ * @file Sprite.h
+ * @brief Allocates sprites and submits them to objectAttributeBuffer in draw order
+ *
+ * Rather than picking slots of objectAttributeBuffer by hand, allocate a SpriteHandle with Sprite_Alloc() and set
+ * it up through the ObjectAttribute_* methods on Sprite_GetAttribute(). Sprite_Commit() then writes every
+ * allocated sprite into objectAttributeBuffer sorted by priority and depth, and hides the slots left over.
+ *
+ * @code
+ * Sprite_Init();
+ *
+ * SpriteHandle whale = Sprite_Alloc();
+ * ObjectAttribute_SetPos(Sprite_GetAttribute(whale), 10, 20);
+ * Sprite_SetDepth(whale, 4);
+ *
+ * Sprite_Commit();
+ * SystemCall_WaitForVBlank();
+ * ObjectAttributeBuffer_CopyBufferToMemory();
+ * @endcode
+ *
+ * Allocating and freeing are O(1), and Sprite_Commit() is a two pass radix sort, so neither gets slower as sprites
+ * come and go. The affine matrices interlaced with objectAttributeBuffer are not touched.
+ *
+ * For more sprites than fit in object attribute memory at once, see SpriteMultiplexer.h.
+ *
+ * @defgroup SPRITE Sprite allocation
+ * @{
+ */
+
+#pragma once
+
+#include "GbaTypes.h"
+#include "ObjectAttribute.h"
+
+/** The maximum number of sprites which can be allocated at once */
+#define Sprite_MaxSprites ObjectAttributeBuffer_Length
+
+/** Identifies an allocated sprite. Valid from Sprite_Alloc() until it is passed to Sprite_Free() */
+typedef int SpriteHandle;
+
+/** Returned by Sprite_Alloc() when every sprite is already in use */
+#define Sprite_InvalidHandle (-1)
+
+/** Frees every sprite and hides everything in objectAttributeBuffer */
+void Sprite_Init(void);
+
+/**
+ * @brief Allocates a sprite, or returns Sprite_InvalidHandle if all Sprite_MaxSprites are in use
+ *
+ * The new sprite is a visible 8x8 sprite at (0, 0) showing tile 0 with depth 0.
+ */
+SpriteHandle Sprite_Alloc(void);
+
+/** Frees @p handle. It is hidden at the next Sprite_Commit() */
+void Sprite_Free(SpriteHandle handle);
+
+/**
+ * @brief Returns the attributes of @p handle, to be changed with the ObjectAttribute_* methods
+ *
+ * These are <i>not</i> in objectAttributeBuffer, and only get copied there by Sprite_Commit().
+ */
+struct ObjectAttribute *Sprite_GetAttribute(SpriteHandle handle);
+
+/**
+ * @brief Sets the order of @p handle relative to other sprites with the same priority
+ *
+ * Sprites with a lower depth are drawn on top of sprites with a higher depth. Sprites with the same priority and
+ * depth are drawn in an unspecified order.
+ */
+void Sprite_SetDepth(SpriteHandle handle, u8 depth);
+
+/**
+ * @brief Rebuilds objectAttributeBuffer from the allocated sprites
+ *
+ * Sprites are sorted by priority (see ObjectAttribute_SetPriority()) and then by depth. Slots which are no longer
+ * used are hidden. Only slots whose contents actually changed are marked dirty, so call this every frame before
+ * ObjectAttributeBuffer_CopyBufferToMemory().
+ */
+void Sprite_Commit(void);
+
+/** @} */
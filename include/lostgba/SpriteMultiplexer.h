@@ -0,0 +1,145 @@
+/**
+ * @file SpriteMultiplexer.h
+ * @brief More than 128 sprites on screen by reusing hardware sprites further down the screen
+ *
+ * The multiplexer manages <i>virtual</i> sprites, allocated and set up just like the ones in Sprite.h, and shares a
+ * range of the hardware slots between them. SpriteMultiplexer_Commit() sorts the visible virtual sprites by their
+ * top line. The topmost ones go straight into objectAttributeBuffer as usual. Each of the rest takes over a slot
+ * whose sprite has already finished drawing, and is written directly to object attribute memory part way down the
+ * screen by a VCount interrupt.
+ *
+ * @code
+ * Interrupt_Init();
+ * Interrupt_EnableType(InterruptType_VBlank);
+ * Interrupt_SetNestable(InterruptType_VCount, true);
+ * Interrupt_Enable();
+ *
+ * Sprite_Init();
+ * SpriteMultiplexer_Init(32); // Sprite.h keeps slots 0 - 31, the multiplexer gets the other 96
+ *
+ * SpriteMultiplexerHandle bullet = SpriteMultiplexer_Alloc();
+ * ObjectAttribute_SetPos(SpriteMultiplexer_GetAttribute(bullet), 10, 20);
+ *
+ * while (true)
+ * {
+ *     Sprite_Commit();
+ *     SpriteMultiplexer_Commit();
+ *     SystemCall_WaitForVBlank();
+ *     ObjectAttributeBuffer_CopyBufferToMemory();
+ * }
+ * @endcode
+ *
+ * Slots are rewritten at most once every SpriteMultiplexer_BandHeight lines, so there are never more than
+ * SpriteMultiplexer_MaxBands interrupts a frame, and each one only copies the sprites starting in the next band.
+ * A sprite can reuse a slot once the slot's previous sprite ended at or above the start of the band, and it must
+ * start at least 2 lines after the start of the band. Each interrupt copies at most
+ * SpriteMultiplexer_MaxWritesPerBand sprites, so that it is always done before the hardware starts drawing them. If
+ * no slot is free in time, or the band is already full, the sprite is dropped for that frame and counted in
+ * SpriteMultiplexerStats::droppedSprites.
+ *
+ * The hardware can only draw so many sprite pixels on each line (see SpriteMultiplexer_LineCycleBudget), and
+ * sprites past that limit are cut off however many slots there are. SpriteMultiplexer_Commit() works out the cost
+ * of every line so that overflows can be found with SpriteMultiplexer_GetStats() and
+ * SpriteMultiplexer_GetLineCycles().
+ *
+ * The order multiplexed sprites overlap in is not controlled, so give overlapping sprites different priorities
+ * (or use Sprite.h for them). Affine sprites can be multiplexed, but the matrices are not.
+ *
+ * @defgroup SPRITE_MULTIPLEXER Sprite multiplexer
+ * @{
+ */
+
+#pragma once
+
+#include "GbaTypes.h"
+#include "ObjectAttribute.h"
+
+/** The maximum number of virtual sprites which can be allocated at once */
+#define SpriteMultiplexer_MaxSprites 512
+
+/** How many lines apart the VCount interrupts which rewrite slots can be */
+#define SpriteMultiplexer_BandHeight 8
+
+/** The most VCount interrupts in a frame */
+#define SpriteMultiplexer_MaxBands (160 / SpriteMultiplexer_BandHeight)
+
+/**
+ * @brief The most sprites one VCount interrupt copies into slots
+ *
+ * Every copy has to be finished within the line after the interrupt fires, which is 1232 cycles including getting
+ * into the handler. Each sprite costs about 20 cycles, so this keeps the handler to around half a line and leaves
+ * room for the interrupt to be held up by other handlers. The bench ROM's sprite_multiplexer_band zone measures it.
+ */
+#define SpriteMultiplexer_MaxWritesPerBand 32
+
+/**
+ * @brief The number of cycles the hardware has to draw the sprites on each line
+ *
+ * A normal sprite costs its width in pixels, and an affine one costs 10 plus twice the width of its render area.
+ */
+#define SpriteMultiplexer_LineCycleBudget 1210
+
+/** Identifies a virtual sprite. Valid from SpriteMultiplexer_Alloc() until it is passed to SpriteMultiplexer_Free() */
+typedef int SpriteMultiplexerHandle;
+
+/** Returned by SpriteMultiplexer_Alloc() when every virtual sprite is already in use */
+#define SpriteMultiplexer_InvalidHandle (-1)
+
+/** What the last SpriteMultiplexer_Commit() did */
+struct SpriteMultiplexerStats
+{
+    /** The number of virtual sprites which were on screen */
+    int visibleSprites;
+    /** How many of those didn't get a slot, and so won't be drawn */
+    int droppedSprites;
+    /** The number of VCount interrupts needed */
+    int bandCount;
+    /** The number of lines costing more than SpriteMultiplexer_LineCycleBudget */
+    int overflowLines;
+    /** The line with the highest cost */
+    int worstLine;
+    /** The cost of worstLine */
+    int worstLineCycles;
+};
+
+/**
+ * @brief Frees every virtual sprite and takes over slots @p firstSlot to 127 of objectAttributeBuffer
+ *
+ * Call after Sprite_Init() and Interrupt_Init(). Don't allocate more than @p firstSlot sprites with Sprite.h after
+ * this. Adds VBlank and VCount handlers and enables the VCount interrupt. VBlank interrupts must be enabled too.
+ */
+void SpriteMultiplexer_Init(int firstSlot);
+
+/**
+ * @brief Allocates a virtual sprite, or returns SpriteMultiplexer_InvalidHandle if there are none left
+ *
+ * The new sprite is a visible 8x8 sprite at (0, 0) showing tile 0.
+ */
+SpriteMultiplexerHandle SpriteMultiplexer_Alloc(void);
+
+/** Frees @p handle. It disappears at the next SpriteMultiplexer_Commit() */
+void SpriteMultiplexer_Free(SpriteMultiplexerHandle handle);
+
+/**
+ * @brief Returns the attributes of @p handle, to be changed with the ObjectAttribute_* methods
+ *
+ * These are <i>not</i> in objectAttributeBuffer, and are only read by SpriteMultiplexer_Commit().
+ */
+struct ObjectAttribute *SpriteMultiplexer_GetAttribute(SpriteMultiplexerHandle handle);
+
+/**
+ * @brief Works out which virtual sprites go in which slots for the next frame
+ *
+ * Call every frame before vblank, and call ObjectAttributeBuffer_CopyBufferToMemory() after it. The new
+ * arrangement is copied into IWRAM for the VCount interrupts at the next vblank. Runs as ARM code from IWRAM, in time
+ * proportional to the number of virtual sprites.
+ */
+void SpriteMultiplexer_Commit(void);
+
+/** What the last SpriteMultiplexer_Commit() did */
+struct SpriteMultiplexerStats SpriteMultiplexer_GetStats(void);
+
+/** The cost of each of the 160 lines from the last SpriteMultiplexer_Commit(), for the multiplexed sprites only */
+const u32 *SpriteMultiplexer_GetLineCycles(void);
+
+/** @} */
@@ -0,0 +1,78 @@
+/**
+ * @file SpriteTileStream.h
+ * @brief Streams the current animation frame of a sprite sheet into sprite tile memory
+ *
+ * Rather than copying a whole sprite sheet into VRAM up front, each sprite gets a small slot of sprite tile memory
+ * just big enough for one frame. Changing frame queues a copy of that frame's tiles from ROM, and
+ * SpriteTileStream_Flush() does all the queued copies during VBlank. A stream whose frame hasn't changed costs
+ * nothing, so sprite sheets can be much bigger than the 32KB of sprite tile memory.
+ *
+ * @code
+ * struct SpriteTileStream whaleStream;
+ * SpriteTileStream_Init(&whaleStream, whaleTiles, 4, 0);
+ *
+ * SpriteTileStream_SetFrame(&whaleStream, 3);
+ * ObjectAttribute_SetTile(whale, 0);
+ *
+ * SystemCall_WaitForVBlank();
+ * SpriteTileStream_Flush();
+ * @endcode
+ *
+ * The sprite sheet must be uncompressed 4bpp tiles, with each frame's tiles stored consecutively (which is what grit
+ * outputs with meta tiles the size of one frame). Add the image to GRIT_RAW_TILES in the Makefile to stop it being
+ * compressed.
+ *
+ * @defgroup SPRITE_TILE_STREAM Sprite tile streaming
+ * @{
+ */
+
+#pragma once
+
+#include "GbaTypes.h"
+
+/** The maximum number of streams which can have a copy queued at once */
+#define SpriteTileStream_MaxQueued 128
+
+/**
+ * @brief One sprite's slot of sprite tile memory and the sprite sheet it shows frames from
+ *
+ * Set up with SpriteTileStream_Init() and don't touch the fields directly.
+ */
+struct SpriteTileStream
+{
+    /** The sprite sheet in ROM */
+    const u32 *sheet;
+    /** The number of 4bpp tiles in each frame */
+    u16 tilesPerFrame;
+    /** The first tile of the slot in sprite tile memory. This is the value to pass to ObjectAttribute_SetTile() */
+    u16 vramTile;
+    /** The frame which should be shown, or -1 if no frame has been queued yet */
+    s16 frame;
+    /** Whether this stream is waiting in the queue for SpriteTileStream_Flush() */
+    bool queued;
+};
+
+/**
+ * @brief Sets up @p stream to show frames of @p sheet in the slot starting at sprite tile @p vramTile
+ *
+ * Frame 0 is queued straight away if there is room in the queue. The slot is @p tilesPerFrame tiles long, and it is up to you to make sure slots
+ * for different streams don't overlap.
+ */
+void SpriteTileStream_Init(struct SpriteTileStream *stream, const void *sheet, int tilesPerFrame, int vramTile);
+
+/**
+ * @brief Shows frame @p frame of the sprite sheet from the next SpriteTileStream_Flush()
+ *
+ * Does nothing if it is already shown. Returns false, and leaves the old frame showing, if SpriteTileStream_MaxQueued
+ * other streams are already waiting. Try again after the next SpriteTileStream_Flush().
+ */
+bool SpriteTileStream_SetFrame(struct SpriteTileStream *stream, int frame);
+
+/**
+ * @brief Copies the tiles of every stream whose frame has changed into sprite tile memory
+ *
+ * Call this during VBlank, once per frame. Each changed stream costs one DMA of its frame's tiles.
+ */
+void SpriteTileStream_Flush(void);
+
+/** @} */
@@ -1,14 +1,88 @@
 /**
  * @file SystemCalls.h
  * @brief Handles GBA BIOS system calls elegantly-ish
- * 
+ *
  * @defgroup SYSTEM_CALLS System calls
  * @{
  */
 
 #pragma once
 
+#include "GbaTypes.h"
+
+/** Halts the CPU until any enabled interrupt fires */
+void SystemCall_Halt(void);
+
+/**
+ * @brief Halts the CPU until one of the given interrupts fires
+ * @param discardOldFlags If true, interrupts which fired before this call are ignored and we always wait for a new one
+ * @param interruptFlags A bit mask of `1 << InterruptType` values to wait for
+ *
+ * The interrupts must have been enabled with Interrupt_EnableType() otherwise this will hang.
+ */
+void SystemCall_IntrWait(bool discardOldFlags, u16 interruptFlags);
+
 /** Halts the CUP until a VBlank occurs. Ensure that VBlank interrupts are enabled otherwise this will hang. */
 void SystemCall_WaitForVBlank(void);
 
-/** @} */
\ No newline at end of file
+/** Signed division of @p numerator by @p denominator, rounding towards zero. @p denominator must not be 0 */
+s32 SystemCall_Div(s32 numerator, s32 denominator);
+/** The remainder of @p numerator divided by @p denominator. Has the same sign as @p numerator */
+s32 SystemCall_Mod(s32 numerator, s32 denominator);
+/** Calculates both the result of SystemCall_Div() and SystemCall_Mod() in one go, with the remainder put in @p remainder */
+s32 SystemCall_DivMod(s32 numerator, s32 denominator, s32 *remainder);
+
+/** The integer square root of @p value, rounded down */
+u16 SystemCall_Sqrt(u32 value);
+
+/**
+ * @brief The angle of the point (@p x, @p y) from the origin
+ * @param x The x coordinate in 1.14 fixed point
+ * @param y The y coordinate in 1.14 fixed point
+ * @returns The angle, where 0x10000 is a full turn
+ */
+u16 SystemCall_ArcTan2(s16 x, s16 y);
+
+/** Which kind of CpuSet to do */
+enum SystemCallCpuSetMode
+{
+    SystemCallCpuSetMode_Copy16, /**< Copy 16 bits at a time */
+    SystemCallCpuSetMode_Copy32, /**< Copy 32 bits at a time */
+    SystemCallCpuSetMode_Fill16, /**< Fill the destination with the 16 bit value pointed to by the source */
+    SystemCallCpuSetMode_Fill32  /**< Fill the destination with the 32 bit value pointed to by the source */
+};
+
+/**
+ * @brief Copies or fills memory with the BIOS
+ * @param source Where to copy from, or a pointer to the value to fill with
+ * @param destination Where to copy to. Must be aligned to the unit size
+ * @param count The number of 16 or 32 bit units to copy (at most 0x1fffff)
+ * @param mode What kind of copy to do
+ */
+void SystemCall_CpuSet(const void *source, void *destination, u32 count, enum SystemCallCpuSetMode mode);
+
+/**
+ * @brief Copies or fills memory with the BIOS, 8 words at a time
+ * @param source Where to copy from, or a pointer to the 32 bit value to fill with. Must be 4 byte aligned
+ * @param destination Where to copy to. Must be 4 byte aligned
+ * @param wordCount The number of 32 bit words to copy. Rounded up to a multiple of 8
+ * @param fill Whether to fill the destination with *source rather than copying
+ */
+void SystemCall_CpuFastSet(const void *source, void *destination, u32 wordCount, bool fill);
+
+/**
+ * @brief Decompresses LZ77 compressed data (e.g. from `grit -gzl`) 8 bits at a time.
+ *
+ * Only use this for destinations which support 8 bit writes (EWRAM and IWRAM). Use SystemCall_LZ77UnCompVram() for VRAM.
+ */
+void SystemCall_LZ77UnCompWram(const void *source, void *destination);
+/** Decompresses LZ77 compressed data 16 bits at a time, so it is safe to use with VRAM (and palette memory) */
+void SystemCall_LZ77UnCompVram(const void *source, volatile void *destination);
+/** Decompresses run length encoded data (e.g. from `grit -gzr`) 8 bits at a time. Only use for EWRAM and IWRAM */
+void SystemCall_RLUnCompWram(const void *source, void *destination);
+/** Decompresses run length encoded data 16 bits at a time, so it is safe to use with VRAM (and palette memory) */
+void SystemCall_RLUnCompVram(const void *source, volatile void *destination);
+/** Decompresses huffman encoded data (e.g. from `grit -gzh`). Writes 32 bits at a time, so works for any destination */
+void SystemCall_HuffUnComp(const void *source, volatile void *destination);
+
+/** @} */
@@ -0,0 +1,165 @@
+/**
+ * @file Text.h
+ * @brief Drawing text on tiled backgrounds
+ *
+ * There are two ways to draw text, which can both be used on the same background:
+ *
+ * - A TextLayer draws each character in its own 8x8 tile, so text can go anywhere on the background's map.
+ *   Rather than loading the whole font, it keeps a small cache of glyph tiles and only uploads a glyph the first
+ *   time it is printed. Printing a string the cache already has the glyphs for only writes screen entries, a row
+ *   at a time, so HUDs and debug overlays can be reprinted every frame.
+ * - A TextLabel renders a string with proportional spacing into a strip of tiles it owns. It only redraws when
+ *   the string changes, so it suits titles and score counters.
+ *
+ * @code
+ * struct TextLayer hud;
+ * TextLayer_Init(&hud, &Text_DefaultFont, (struct TextLayerSettings){
+ *                                             .tileBlock = 1,
+ *                                             .firstTile = 0,
+ *                                             .cachedGlyphs = 32,
+ *                                             .screenBaseBlock = 31,
+ *                                             .backgroundSize = BackgroundSize_32x32,
+ *                                             .paletteBank = 15,
+ *                                             .colour = 1,
+ *                                         });
+ *
+ * TextLayer_Print(&hud, 1, 1, "SCORE");
+ * TextLayer_PrintNumber(&hud, 7, 1, score, 6);
+ * @endcode
+ *
+ * Glyphs are drawn in a single colour (an index into the 16 colour palette bank), with everything else
+ * transparent. Only 4bpp backgrounds are supported.
+ *
+ * @defgroup TEXT Text
+ * @{
+ */
+
+#pragma once
+
+#include "GbaTypes.h"
+#include "Background.h"
+
+/** The height of every glyph, and the size of a tile */
+#define Text_GlyphHeight 8
+
+/** A 1 bit per pixel font, up to 8 pixels wide */
+struct TextFont
+{
+    /** Text_GlyphHeight bytes per glyph, one for each row from the top. Bit 0 is the leftmost pixel */
+    const u8 *glyphs;
+    /** How far to move right after each glyph in pixels, or NULL to use 8 for every glyph */
+    const u8 *widths;
+    /** The character of the first glyph */
+    u8 firstCharacter;
+    /** The number of glyphs. Characters without a glyph are drawn as spaces */
+    u8 glyphCount;
+};
+
+/** A proportional font with every printable ASCII character, 7 pixels high plus a row for descenders */
+extern const struct TextFont Text_DefaultFont;
+
+/** The width of @p text in pixels when drawn with @p font by a TextLabel */
+int Text_MeasureWidth(const struct TextFont *font, const char *text);
+
+/** The most glyph tiles a TextLayer can cache */
+#define TextLayer_MaxCachedGlyphs 64
+
+/** Where a TextLayer puts its tiles and screen entries */
+struct TextLayerSettings
+{
+    /** The character base block of the background, as set with Background_SetTileBackgroundNumber() */
+    int tileBlock;
+    /** The first tile the layer can use, counting from the start of tileBlock. Always left blank */
+    int firstTile;
+    /** The number of tiles after firstTile used for the cache, up to TextLayer_MaxCachedGlyphs */
+    int cachedGlyphs;
+    /** The background's screen base block */
+    int screenBaseBlock;
+    /** The background's size */
+    enum BackgroundSize backgroundSize;
+    /** The palette bank for the screen entries */
+    int paletteBank;
+    /** The colour index (1 - 15) within paletteBank to draw glyphs in */
+    int colour;
+};
+
+/**
+ * @brief Text with one glyph per tile, using a least recently used cache of glyph tiles
+ *
+ * The cache should have room for every different glyph on screen at once. Once it is full, the glyph which was
+ * printed longest ago is replaced, and anything still on screen using it will change.
+ */
+struct TextLayer
+{
+    const struct TextFont *font;
+    struct TextLayerSettings settings;
+    /** @internal Increases with every print, to find the least recently used glyph */
+    u32 clock;
+    /** @internal The glyph in each cache slot, or 0xff */
+    u8 slotGlyph[TextLayer_MaxCachedGlyphs];
+    /** @internal The clock when each slot was last printed */
+    u32 slotLastUsed[TextLayer_MaxCachedGlyphs];
+    /** @internal The slot + 1 each glyph is cached in, or 0 */
+    u8 glyphSlot[256];
+};
+
+/** Sets up @p layer and clears its blank tile. Doesn't touch the map */
+void TextLayer_Init(struct TextLayer *layer, const struct TextFont *font, struct TextLayerSettings settings);
+
+/**
+ * @brief Writes @p text to the map with its first character at tile @p x, @p y
+ *
+ * A newline moves down a row and back to @p x. Rows wrap around the edges of the map.
+ */
+void TextLayer_Print(struct TextLayer *layer, int x, int y, const char *text);
+
+/** Prints @p value right aligned in a field @p width characters wide, padded with spaces */
+void TextLayer_PrintNumber(struct TextLayer *layer, int x, int y, s32 value, int width);
+
+/** Blanks a @p width by @p height area of the map */
+void TextLayer_Clear(struct TextLayer *layer, int x, int y, int width, int height);
+
+/** The most characters a TextLabel remembers to check whether its text has changed */
+#define TextLabel_MaxLength 31
+/** The most tiles wide a TextLabel can be */
+#define TextLabel_MaxTiles 16
+
+/** Where a TextLabel puts its tiles and screen entries */
+struct TextLabelSettings
+{
+    /** The character base block of the background, as set with Background_SetTileBackgroundNumber() */
+    int tileBlock;
+    /** The first of widthInTiles tiles the label draws into, counting from the start of tileBlock */
+    int firstTile;
+    /** How many tiles wide the label is, up to TextLabel_MaxTiles. Text past the end is cut off */
+    int widthInTiles;
+    /** The background's screen base block */
+    int screenBaseBlock;
+    /** The background's size */
+    enum BackgroundSize backgroundSize;
+    /** Where the label goes on the map, in tiles */
+    int x;
+    /** Where the label goes on the map, in tiles */
+    int y;
+    /** The palette bank for the screen entries */
+    int paletteBank;
+    /** The colour index (1 - 15) within paletteBank to draw glyphs in */
+    int colour;
+};
+
+/** A single line of proportionally spaced text, which only redraws when it changes */
+struct TextLabel
+{
+    const struct TextFont *font;
+    struct TextLabelSettings settings;
+    /** @internal What is currently drawn */
+    char text[TextLabel_MaxLength + 1];
+};
+
+/** Sets up @p label, writes its screen entries to the map and clears it */
+void TextLabel_Init(struct TextLabel *label, const struct TextFont *font, struct TextLabelSettings settings);
+
+/** Changes the text of @p label. Does nothing if it is the same as the current text */
+void TextLabel_Set(struct TextLabel *label, const char *text);
+
+/** @} */
@@ -2,6 +2,13 @@
  * @file TileMap.h
  * @brief Handle tilemaps and palettes for sprites and backgrounds
  * 
+ * Tiles and palettes can either be copied uncompressed with the TileMap_CopyTo* functions, or decompressed straight
+ * into VRAM with the TileMap_LoadCompressed* functions. The compressed versions accept any LZ77, run length or huffman
+ * compressed data in the format the BIOS understands (which is what grit outputs with the -gz / -pz flags).
+ *
+ * The palette functions here write straight to palette memory. To fade or otherwise change palettes while the game
+ * is running, load them with the Palette module (Palette.h) instead, which only uploads the banks which change.
+ *
  * @defgroup TILEMAP Tile maps
  * @{
  */
@@ -42,6 +49,27 @@ void TileMap_CopyToSpritePalette(const u16 paletteData[TileMap_PaletteLength]);
  */
 void LOSTGBA_UNSAFE(TileMap_CopyToSpriteTiles)(int tileNumber, const unsigned int *tileData, int length);
 
+/** Decompresses the provided compressed palette data into the sprite palette memory location */
+void TileMap_LoadCompressedSpritePalette(const void *compressedPaletteData);
+/**
+ * @brief Decompresses tiles straight into the sprite tile memory
+ * @param tileNumber The sprite background block number. Either 0 or 1
+ * @param compressedTileData The compressed tile data
+ *
+ * Same as TileMap_CopyToSpriteTiles() but for compressed tile data. The length is stored in the compressed data.
+ */
+#define TileMap_LoadCompressedSpriteTiles(tileNumber, compressedTileData)                                \
+    do                                                                                                   \
+    {                                                                                                    \
+        _Static_assert(0 <= tileNumber && tileNumber <= 1, "Sprites can only use tile numbers 0 and 1"); \
+        LOSTGBA_UNSAFE(TileMap_LoadCompressedSpriteTiles)                                                \
+        (tileNumber, compressedTileData);                                                                \
+    } while (0)
+/**
+ * The unsafe version of TileMap_LoadCompressedSpriteTiles
+ */
+void LOSTGBA_UNSAFE(TileMap_LoadCompressedSpriteTiles)(int tileNumber, const void *compressedTileData);
+
 /**
  * @brief Copies the provided palette data to the background palette memory location
  * 
@@ -69,4 +97,25 @@ void TileMap_CopyToBackgroundPalette(const u16 paletteData[TileMap_PaletteLength
  */
 void LOSTGBA_UNSAFE(TileMap_CopyToBackgroundTiles)(int backgroundNumber, const unsigned int *tileData, int length);
 
+/** Decompresses the provided compressed palette data into the background palette memory location */
+void TileMap_LoadCompressedBackgroundPalette(const void *compressedPaletteData);
+/**
+ * @brief Decompresses tiles straight into the background tile memory
+ * @param backgroundNumber The tile block number to use. Must be between 0 and 3 inclusive.
+ * @param compressedTileData The compressed tile data
+ *
+ * Same as TileMap_CopyToBackgroundTiles() but for compressed tile data. The length is stored in the compressed data.
+ */
+#define TileMap_LoadCompressedBackgroundTiles(backgroundNumber, compressedTileData)                                            \
+    do                                                                                                                         \
+    {                                                                                                                          \
+        _Static_assert(0 <= backgroundNumber && backgroundNumber <= 3, "Background number must be between 0 and 3 inclusive"); \
+        LOSTGBA_UNSAFE(TileMap_LoadCompressedBackgroundTiles)                                                                  \
+        (backgroundNumber, compressedTileData);                                                                                \
+    } while (0)
+/**
+ * The unsafe version of TileMap_LoadCompressedBackgroundTiles
+ */
+void LOSTGBA_UNSAFE(TileMap_LoadCompressedBackgroundTiles)(int backgroundNumber, const void *compressedTileData);
+
 /** @} */
\ No newline at end of file
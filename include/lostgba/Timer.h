@@ -0,0 +1,66 @@
+/**
+ * @file Timer.h
+ * @brief The 4 hardware timers
+ *
+ * Each timer is a 16 bit counter which counts up from a reload value, and goes back to the reload value when it
+ * overflows. They can count CPU cycles (optionally divided by a prescaler), or be cascaded to count the overflows
+ * of the previous timer to make a larger counter.
+ *
+ * @defgroup TIMER Hardware timers
+ * @{
+ */
+
+#pragma once
+
+#include "GbaTypes.h"
+
+/** The timer to use. Timer 0 is used by the Sound module and timers 2 and 3 by the Profile module if you use those */
+enum TimerNumber
+{
+    TimerNumber_0, /**< Timer 0 */
+    TimerNumber_1, /**< Timer 1. Can cascade from timer 0 */
+    TimerNumber_2, /**< Timer 2. Can cascade from timer 1 */
+    TimerNumber_3  /**< Timer 3. Can cascade from timer 2 */
+};
+
+/** How many CPU cycles it takes for the timer to count up by 1 */
+enum TimerPrescaler
+{
+    TimerPrescaler_1,   /**< Counts every cycle (16.78MHz) */
+    TimerPrescaler_64,  /**< Counts every 64 cycles (262.21kHz) */
+    TimerPrescaler_256, /**< Counts every 256 cycles (65.536kHz) */
+    TimerPrescaler_1024 /**< Counts every 1024 cycles (16.384kHz) */
+};
+
+/** Full timer control. The zero value counts every cycle without firing interrupts */
+struct TimerSettings
+{
+    /** Ignored if cascade is true */
+    enum TimerPrescaler prescaler;
+    /** Count up once every time the previous timer overflows rather than using the prescaler. Not valid for timer 0 */
+    bool cascade;
+    /** Fire the InterruptType_Timer* interrupt for this timer on overflow. Same as calling Interrupt_EnableType() */
+    bool interruptOnOverflow;
+} LOSTGBA_PACKED_ALIGN(4);
+
+/** The number of CPU cycles per second */
+#define Timer_CyclesPerSecond 16777216
+
+/**
+ * @brief (Re)starts the given timer
+ * @param timer The timer to start
+ * @param reload The value the timer starts counting from, and resets to on overflow
+ * @param settings How the timer should count
+ */
+void Timer_Start(enum TimerNumber timer, u16 reload, struct TimerSettings settings);
+
+/** Stops the given timer. The count stays at whatever value it got to */
+void Timer_Stop(enum TimerNumber timer);
+
+/** The current count of the given timer */
+u16 Timer_GetCount(enum TimerNumber timer);
+
+/** Controls whether the given timer fires an interrupt on overflow. Called for you by Interrupt_EnableType() */
+void Timer_SetInterruptEnabled(enum TimerNumber timer, bool enabled);
+
+/** @} */
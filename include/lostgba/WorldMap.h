@@ -0,0 +1,102 @@
+/**
+ * @file WorldMap.h
+ * @brief Scrolls a background over a map far bigger than the background itself
+ *
+ * The whole map lives in ROM (or EWRAM if it was compressed), and the background is used as a ring buffer which only
+ * ever holds the 31 x 21 tiles which can be on screen at once. As the camera moves, WorldMap_Commit() writes just
+ * the rows and columns which have come into view, so the cost per frame depends on how far the camera moved and not
+ * on the size of the map.
+ *
+ * @code
+ * struct WorldMap level;
+ * WorldMap_Init(&level, levelMap, LEVEL_WIDTH, LEVEL_HEIGHT, BackgroundNumber_0, 30, BackgroundSize_32x32);
+ *
+ * while (true)
+ * {
+ *     WorldMap_SetCamera(&level, cameraX, cameraY);
+ *
+ *     SystemCall_WaitForVBlank();
+ *     WorldMap_Commit(&level);
+ * }
+ * @endcode
+ *
+ * The background still has to be set up with the screen base block and size passed to WorldMap_Init().
+ *
+ * @defgroup WORLD_MAP World maps
+ * @{
+ */
+
+#pragma once
+
+#include "GbaTypes.h"
+#include "Background.h"
+
+/** The number of columns of tiles which can be (partially) on screen at once */
+#define WorldMap_WindowWidth 31
+/** The number of rows of tiles which can be (partially) on screen at once */
+#define WorldMap_WindowHeight 21
+
+/** A map being streamed into a background. Set up with WorldMap_Init() and don't touch the fields directly */
+struct WorldMap
+{
+    /** The screen entries of the whole map, row by row */
+    const u16 *entries;
+    /** The width of the map in tiles */
+    int width;
+    /** The height of the map in tiles */
+    int height;
+
+    enum BackgroundNumber backgroundNumber;
+    int screenBaseBlock;
+    enum BackgroundSize backgroundSize;
+
+    /** The camera position in pixels, from WorldMap_SetCamera() */
+    int cameraX;
+    int cameraY;
+
+    /** The top left tile of the part of the map currently in the background */
+    int loadedTileX;
+    int loadedTileY;
+    /** Whether anything has been loaded into the background yet */
+    bool loaded;
+};
+
+/**
+ * @brief Sets up @p map to stream @p entries into the given background
+ * @param map The map to set up
+ * @param entries The screen entries of the map, row by row, as created by Background_MakeScreenEntry(). Not copied
+ * @param width The width of the map in tiles. Must be at least WorldMap_WindowWidth
+ * @param height The height of the map in tiles. Must be at least WorldMap_WindowHeight
+ * @param backgroundNumber The background to scroll
+ * @param screenBaseBlock The screen base block of the background
+ * @param backgroundSize The size of the background. Any size works, but BackgroundSize_32x32 is enough
+ *
+ * The camera starts at (0, 0) and the whole window is written by the first WorldMap_Commit().
+ */
+void WorldMap_Init(struct WorldMap *map, const u16 *entries, int width, int height,
+                   enum BackgroundNumber backgroundNumber, int screenBaseBlock, enum BackgroundSize backgroundSize);
+
+/**
+ * @brief Same as WorldMap_Init() but for a map compressed in a format the BIOS understands
+ * @param buffer Where to decompress the map to. Must have room for @p width * @p height entries, so normally in EWRAM
+ *
+ * The map is decompressed once up front, and streamed from @p buffer afterwards.
+ */
+void WorldMap_InitCompressed(struct WorldMap *map, const void *compressedEntries, u16 *buffer, int width, int height,
+                             enum BackgroundNumber backgroundNumber, int screenBaseBlock, enum BackgroundSize backgroundSize);
+
+/**
+ * @brief Moves the camera so that pixel (@p x, @p y) of the map is at the top left of the screen
+ *
+ * The camera is kept inside the map. Nothing is written until WorldMap_Commit(), so this is safe to call at any time.
+ */
+void WorldMap_SetCamera(struct WorldMap *map, int x, int y);
+
+/**
+ * @brief Writes the newly visible rows and columns into the background and sets its scroll
+ *
+ * Call this during vblank. Moving the camera by more than a screen redraws the whole window.
+ */
+void WorldMap_Commit(struct WorldMap *map);
+
+/** @} */
@@ -0,0 +1,146 @@
+#include <lostgba/Animation.h>
+
+#include <stddef.h>
+
+static struct Animator *Animation_active[Animation_MaxAnimators];
+static int Animation_activeCount = 0;
+
+bool Animator_Init(struct Animator *animator, struct ObjectAttribute *attr, struct SpriteTileStream *stream)
+{
+    // An animator being initialised again keeps its place in the list rather than being added twice.
+    // Search the list rather than trusting activeIndex, which isn't set until the first Init
+    bool active = false;
+    for (int i = 0; i < Animation_activeCount; i++)
+    {
+        if (Animation_active[i] == animator)
+        {
+            active = true;
+            break;
+        }
+    }
+
+    if (!active && Animation_activeCount == Animation_MaxAnimators)
+    {
+        return false;
+    }
+
+    animator->clip = NULL;
+    animator->attr = attr;
+    animator->stream = stream;
+    animator->frameIndex = 0;
+    animator->ticksLeft = 0;
+    animator->finished = false;
+    animator->pending = false;
+    animator->offsetX = 0;
+    animator->offsetY = 0;
+
+    if (!active)
+    {
+        animator->activeIndex = Animation_activeCount;
+        Animation_active[Animation_activeCount++] = animator;
+    }
+
+    return true;
+}
+
+void Animator_Remove(struct Animator *animator)
+{
+    // Move the last animator into the gap so the list stays packed
+    struct Animator *last = Animation_active[--Animation_activeCount];
+    Animation_active[animator->activeIndex] = last;
+    last->activeIndex = animator->activeIndex;
+}
+
+static void Animator_showFrame(struct Animator *animator)
+{
+    const struct AnimationFrame *frame = &animator->clip->frames[animator->frameIndex];
+
+    animator->ticksLeft = frame->duration;
+    animator->offsetX = frame->offsetX;
+    animator->offsetY = frame->offsetY;
+
+    struct ObjectAttribute *attr = animator->attr;
+    if (!attr)
+    {
+        return;
+    }
+
+    if (animator->stream)
+    {
+        // If the stream couldn't be queued, try again on the next update rather than waiting for the next frame
+        animator->pending = !SpriteTileStream_SetFrame(animator->stream, frame->tile);
+        if (animator->pending)
+        {
+            animator->ticksLeft = 1;
+        }
+    }
+    else
+    {
+        ObjectAttribute_SetTile(attr, frame->tile);
+    }
+
+    ObjectAttribute_SetHFlip(attr, frame->flags & AnimationFrameFlag_HFlip);
+    ObjectAttribute_SetVFlip(attr, frame->flags & AnimationFrameFlag_VFlip);
+}
+
+void Animator_Play(struct Animator *animator, const struct AnimationClip *clip)
+{
+    if (animator->clip == clip)
+    {
+        return;
+    }
+
+    animator->clip = clip;
+    animator->frameIndex = 0;
+    animator->finished = false;
+    Animator_showFrame(animator);
+}
+
+void Animation_UpdateAll(void)
+{
+    for (int i = 0; i < Animation_activeCount; i++)
+    {
+        struct Animator *animator = Animation_active[i];
+
+        // Most animators are part way through a frame, so keep that path as short as possible
+        if (animator->ticksLeft > 1)
+        {
+            animator->ticksLeft--;
+            continue;
+        }
+
+        if (animator->pending)
+        {
+            Animator_showFrame(animator);
+            continue;
+        }
+
+        if (animator->finished || !animator->clip)
+        {
+            continue;
+        }
+
+        int nextFrame = animator->frameIndex + 1;
+        if (nextFrame == animator->clip->frameCount)
+        {
+            if (animator->clip->loopMode == AnimationLoopMode_Once)
+            {
+                animator->ticksLeft = 0;
+                animator->finished = true;
+                continue;
+            }
+
+            nextFrame = 0;
+        }
+
+        // Clips with a single looping frame never need anything changing
+        if (nextFrame == animator->frameIndex)
+        {
+            animator->ticksLeft = animator->clip->frames[nextFrame].duration;
+            continue;
+        }
+
+        animator->frameIndex = nextFrame;
+        Animator_showFrame(animator);
+    }
+}
@@ -1,7 +1,9 @@
 #include <lostgba/Background.h>
+#include <lostgba/Dma.h>
+#include <lostgba/Interrupt.h>
 #include "LostGbaInternal.h"
 
-u16 *Background_ControlRegisterBaseAddr = (u16 *)0x04000008;
+u16 *Background_ControlRegisterBaseAddr = (u16 *)LOSTGBA_ADDRESS(0x04000008);
 
 static void Background_setBits(enum BackgroundNumber backgroundNumber, u16 value, u16 length, u16 shift)
 {
@@ -33,40 +35,79 @@ void Background_SetSize(enum BackgroundNumber backgroundNumber, enum BackgroundS
     Background_setBits(backgroundNumber, backgroundSize, 2, 14);
 }
 
-static u16 Background_makeScreenEntry(int tileId, bool hflip, bool vflip, int paletteBank)
+// Each background has a horizontal offset register followed by a vertical one
+static vu32 *Background_scrollRegisterBaseAddr = (vu32 *)LOSTGBA_ADDRESS(0x04000010);
+
+void Background_SetScroll(enum BackgroundNumber backgroundNumber, int x, int y)
 {
-    return (tileId & LostGBA_AllOnes16(10)) |
-           (hflip << 10) |
-           (vflip << 11) |
-           (paletteBank << 12);
+    Background_scrollRegisterBaseAddr[backgroundNumber] = (x & LostGBA_AllOnes16(9)) | ((y & LostGBA_AllOnes16(9)) << 16);
 }
 
-static int Background_screenBlockOffset(enum BackgroundSize backgroundSize, int x, int y)
+// The hblank after the last visible line also triggers a transfer, so each table has one extra entry which
+// is never seen.
+static struct BackgroundScrollOffset Background_scrollTables[2][Background_ScrollTableLength + 1];
+static int Background_scrollTableFront = 0;
+static volatile bool Background_scrollTableSwapRequested = false;
+static bool Background_scrollTableEnabled = false;
+static enum BackgroundNumber Background_scrollTableBackground;
+
+// Restarts the scroll table DMA for the next frame. The DMA only moves its source on, so without this it would run
+// off the end of the table and into whatever comes after it
+static void Background_scrollTableVBlank(void)
 {
-    switch (backgroundSize)
+    if (!Background_scrollTableEnabled)
+    {
+        return;
+    }
+
+    if (Background_scrollTableSwapRequested)
     {
-    case BackgroundSize_32x32:
-        return 0;
-    case BackgroundSize_32x64:
-        return y >= 32;
-    case BackgroundSize_64x32:
-        return x >= 32;
-    case BackgroundSize_64x64:
-        return x / 32 + 2 * (y / 32);
-    default:
-        LOSTGBA_UNREACHABLE();
+        Background_scrollTableFront = !Background_scrollTableFront;
+        Background_scrollTableSwapRequested = false;
     }
+
+    const struct BackgroundScrollOffset *table = Background_scrollTables[Background_scrollTableFront];
+    vu32 *scrollRegister = &Background_scrollRegisterBaseAddr[Background_scrollTableBackground];
+
+    // Line 0 is drawn before the first hblank, so gets set now. The DMA then sets each following line
+    // during the hblank before it.
+    *scrollRegister = *(const u32 *)&table[0];
+    Dma_Start(DmaChannel_0, &table[1], scrollRegister, 1,
+              (struct DmaSettings){
+                  .destinationControl = DmaAddressControl_Fixed,
+                  .sourceControl = DmaAddressControl_Increment,
+                  .chunkSize = DmaChunkSize_32,
+                  .timing = DmaTiming_HBlank,
+                  .repeat = true,
+              });
 }
 
-#define VRAM_BASE ((u16 *)0x06000000)
-#define SCREEN_BLOCK_LENGTH 1024
+void Background_EnableScrollTable(enum BackgroundNumber backgroundNumber)
+{
+    static bool handlerAdded = false;
+
+    Background_scrollTableBackground = backgroundNumber;
+    Background_scrollTableEnabled = true;
 
-void LOSTGBA_UNSAFE(Background_SetTile)(int screenBaseBlock, enum BackgroundSize backgroundSize, int x, int y, int tileId, bool hflip, bool vflip, int paletteBank)
+    if (!handlerAdded)
+    {
+        Interrupt_AddHandler(InterruptType_VBlank, Background_scrollTableVBlank, 0);
+        handlerAdded = true;
+    }
+}
+
+void Background_DisableScrollTable(void)
 {
-    u16 screenEntry = Background_makeScreenEntry(tileId, hflip, vflip, paletteBank);
+    Background_scrollTableEnabled = false;
+    Dma_Stop(DmaChannel_0);
+}
 
-    int screenBlockStep = (x % 32) + (y % 32) * 32;
-    int screenBlockOffset = Background_screenBlockOffset(backgroundSize, x, y);
+struct BackgroundScrollOffset *Background_GetScrollTable(void)
+{
+    return Background_scrollTables[!Background_scrollTableFront];
+}
 
-    *(VRAM_BASE + (SCREEN_BLOCK_LENGTH * (screenBaseBlock + screenBlockOffset)) + screenBlockStep) = screenEntry;
-}
\ No newline at end of file
+void Background_SwapScrollTable(void)
+{
+    Background_scrollTableSwapRequested = true;
+}
@@ -0,0 +1,181 @@
+// Screen entry writers. Map streaming calls these for every new row and column, so they are compiled as ARM code
+// and run from IWRAM (see the *.iwram.c rule in the Makefile).
+
+#include <lostgba/Background.h>
+#include "LostGbaInternal.h"
+
+static int Background_screenBlockOffset(enum BackgroundSize backgroundSize, int x, int y)
+{
+    switch (backgroundSize)
+    {
+    case BackgroundSize_32x32:
+        return 0;
+    case BackgroundSize_32x64:
+        return y >= 32;
+    case BackgroundSize_64x32:
+        return x >= 32;
+    case BackgroundSize_64x64:
+        return x / 32 + 2 * (y / 32);
+    default:
+        LOSTGBA_UNREACHABLE();
+    }
+}
+
+#define VRAM_BASE ((u16 *)LOSTGBA_ADDRESS(0x06000000))
+#define SCREEN_BLOCK_LENGTH 1024
+
+// x and y must be inside the map
+static u16 *Background_screenEntryAddress(int screenBaseBlock, enum BackgroundSize backgroundSize, int x, int y)
+{
+    int screenBlockStep = (x % 32) + (y % 32) * 32;
+    int screenBlockOffset = Background_screenBlockOffset(backgroundSize, x, y);
+
+    return VRAM_BASE + (SCREEN_BLOCK_LENGTH * (screenBaseBlock + screenBlockOffset)) + screenBlockStep;
+}
+
+void LOSTGBA_UNSAFE(Background_SetTile)(int screenBaseBlock, enum BackgroundSize backgroundSize, int x, int y, int tileId, bool hflip, bool vflip, int paletteBank)
+{
+    u16 screenEntry = Background_MakeScreenEntry(tileId, hflip, vflip, paletteBank);
+
+    *Background_screenEntryAddress(screenBaseBlock, backgroundSize, x, y) = screenEntry;
+}
+
+static int Background_mapWidth(enum BackgroundSize backgroundSize)
+{
+    return (backgroundSize == BackgroundSize_64x32 || backgroundSize == BackgroundSize_64x64) ? 64 : 32;
+}
+
+static int Background_mapHeight(enum BackgroundSize backgroundSize)
+{
+    return (backgroundSize == BackgroundSize_32x64 || backgroundSize == BackgroundSize_64x64) ? 64 : 32;
+}
+
+// Writes entries to a span which doesn't cross a screen block, 2 entries per 32 bit store
+static void Background_copySpan(u16 *destination, const u16 *entries, int length)
+{
+    if ((uintptr_t)destination & 2)
+    {
+        *destination++ = *entries++;
+        length--;
+    }
+
+    u32 *destination32 = (u32 *)destination;
+    for (; length >= 2; length -= 2)
+    {
+        *destination32++ = entries[0] | ((u32)entries[1] << 16);
+        entries += 2;
+    }
+
+    if (length)
+    {
+        *(u16 *)destination32 = *entries;
+    }
+}
+
+// Same as Background_copySpan but with every entry the same
+static void Background_fillSpan(u16 *destination, u16 screenEntry, int length)
+{
+    if ((uintptr_t)destination & 2)
+    {
+        *destination++ = screenEntry;
+        length--;
+    }
+
+    u32 screenEntryPair = screenEntry | ((u32)screenEntry << 16);
+    u32 *destination32 = (u32 *)destination;
+    for (; length >= 2; length -= 2)
+    {
+        *destination32++ = screenEntryPair;
+    }
+
+    if (length)
+    {
+        *(u16 *)destination32 = screenEntry;
+    }
+}
+
+void LOSTGBA_UNSAFE(Background_SetRow)(int screenBaseBlock, enum BackgroundSize backgroundSize, int x, int y, const u16 *entries, int length)
+{
+    int widthMask = Background_mapWidth(backgroundSize) - 1;
+    x &= widthMask;
+    y &= Background_mapHeight(backgroundSize) - 1;
+
+    while (length > 0)
+    {
+        int spanLength = 32 - (x % 32);
+        if (spanLength > length)
+        {
+            spanLength = length;
+        }
+
+        Background_copySpan(Background_screenEntryAddress(screenBaseBlock, backgroundSize, x, y), entries, spanLength);
+
+        entries += spanLength;
+        length -= spanLength;
+        x = (x + spanLength) & widthMask;
+    }
+}
+
+void LOSTGBA_UNSAFE(Background_SetColumn)(int screenBaseBlock, enum BackgroundSize backgroundSize, int x, int y, const u16 *entries, int length)
+{
+    int heightMask = Background_mapHeight(backgroundSize) - 1;
+    x &= Background_mapWidth(backgroundSize) - 1;
+    y &= heightMask;
+
+    while (length > 0)
+    {
+        int spanLength = 32 - (y % 32);
+        if (spanLength > length)
+        {
+            spanLength = length;
+        }
+
+        u16 *destination = Background_screenEntryAddress(screenBaseBlock, backgroundSize, x, y);
+        for (int i = 0; i < spanLength; i++)
+        {
+            *destination = *entries++;
+            destination += 32;
+        }
+
+        length -= spanLength;
+        y = (y + spanLength) & heightMask;
+    }
+}
+
+void LOSTGBA_UNSAFE(Background_FillRect)(int screenBaseBlock, enum BackgroundSize backgroundSize, int x, int y, int width, int height, u16 screenEntry)
+{
+    int widthMask = Background_mapWidth(backgroundSize) - 1;
+    int heightMask = Background_mapHeight(backgroundSize) - 1;
+    x &= widthMask;
+
+    for (int row = 0; row < height; row++)
+    {
+        int rowY = (y + row) & heightMask;
+        int rowX = x;
+        int remaining = width;
+
+        while (remaining > 0)
+        {
+            int spanLength = 32 - (rowX % 32);
+            if (spanLength > remaining)
+            {
+                spanLength = remaining;
+            }
+
+            Background_fillSpan(Background_screenEntryAddress(screenBaseBlock, backgroundSize, rowX, rowY), screenEntry, spanLength);
+
+            remaining -= spanLength;
+            rowX = (rowX + spanLength) & widthMask;
+        }
+    }
+}
+
+void LOSTGBA_UNSAFE(Background_CopyRect)(int screenBaseBlock, enum BackgroundSize backgroundSize, int x, int y, int width, int height, const u16 *entries, int entriesStride)
+{
+    for (int row = 0; row < height; row++)
+    {
+        LOSTGBA_UNSAFE(Background_SetRow)
+        (screenBaseBlock, backgroundSize, x, y + row, entries, width);
+        entries += entriesStride;
+    }
+}
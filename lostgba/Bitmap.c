@@ -0,0 +1,245 @@
+#include <lostgba/Bitmap.h>
+#include <lostgba/Interrupt.h>
+#include <lostgba/SystemCalls.h>
+
+#include "BitmapInternal.h"
+#include "LostGbaInternal.h"
+
+#define BITMAP_PAGE_0 ((u8 *)LOSTGBA_ADDRESS(0x06000000))
+#define BITMAP_PAGE_1 ((u8 *)LOSTGBA_ADDRESS(0x0600A000))
+
+static enum GraphicsMode Bitmap_mode = GraphicsMode_3;
+static int Bitmap_width = Graphics_ScreenWidth;
+static int Bitmap_height = Graphics_ScreenHeight;
+
+static u8 *Bitmap_backBuffer;
+static int Bitmap_frontPage = 0;
+static volatile bool Bitmap_flipRequested = false;
+
+static bool Bitmap_isDoubleBuffered(void)
+{
+    return Bitmap_mode != GraphicsMode_3;
+}
+
+static void Bitmap_vblank(void)
+{
+    if (!Bitmap_flipRequested)
+    {
+        return;
+    }
+
+    Bitmap_frontPage = !Bitmap_frontPage;
+    Graphics_SetDisplayedFrame(Bitmap_frontPage);
+    Bitmap_backBuffer = Bitmap_frontPage ? BITMAP_PAGE_0 : BITMAP_PAGE_1;
+    Bitmap_flipRequested = false;
+}
+
+void Bitmap_Init(enum GraphicsMode mode)
+{
+    static bool handlerAdded = false;
+
+    Bitmap_mode = mode;
+    Bitmap_width = mode == GraphicsMode_5 ? 160 : Graphics_ScreenWidth;
+    Bitmap_height = mode == GraphicsMode_5 ? 128 : Graphics_ScreenHeight;
+
+    Bitmap_frontPage = 0;
+    Bitmap_flipRequested = false;
+    Graphics_SetDisplayedFrame(0);
+    Bitmap_backBuffer = Bitmap_isDoubleBuffered() ? BITMAP_PAGE_1 : BITMAP_PAGE_0;
+
+    if (!handlerAdded)
+    {
+        Interrupt_AddHandler(InterruptType_VBlank, Bitmap_vblank, 0);
+        handlerAdded = true;
+    }
+}
+
+int Bitmap_Width(void)
+{
+    return Bitmap_width;
+}
+
+int Bitmap_Height(void)
+{
+    return Bitmap_height;
+}
+
+void *Bitmap_GetBackBuffer(void)
+{
+    return Bitmap_backBuffer;
+}
+
+void Bitmap_Flip(void)
+{
+    if (Bitmap_isDoubleBuffered())
+    {
+        Bitmap_flipRequested = true;
+    }
+}
+
+bool Bitmap_IsFlipPending(void)
+{
+    return Bitmap_flipRequested;
+}
+
+void Bitmap_WaitForFlip(void)
+{
+    while (Bitmap_flipRequested)
+    {
+        SystemCall_WaitForVBlank();
+    }
+}
+
+void Bitmap_Clear(u16 colour)
+{
+    Bitmap_FillRect(0, 0, Bitmap_width, Bitmap_height, colour);
+}
+
+void Bitmap_SetPixel(int x, int y, u16 colour)
+{
+    Bitmap_FillRect(x, y, 1, 1, colour);
+}
+
+void Bitmap_FillSpan(int x, int y, int length, u16 colour)
+{
+    Bitmap_FillRect(x, y, length, 1, colour);
+}
+
+// Clips the span starting at *start of length *length to [0, limit). Returns false if nothing is left
+static bool Bitmap_clipSpan(int *start, int *length, int limit, int *skipped)
+{
+    *skipped = 0;
+    if (*start < 0)
+    {
+        *skipped = -*start;
+        *length += *start;
+        *start = 0;
+    }
+
+    if (*start + *length > limit)
+    {
+        *length = limit - *start;
+    }
+
+    return *length > 0;
+}
+
+void Bitmap_FillRect(int x, int y, int width, int height, u16 colour)
+{
+    int skippedX, skippedY;
+    if (!Bitmap_clipSpan(&x, &width, Bitmap_width, &skippedX) || !Bitmap_clipSpan(&y, &height, Bitmap_height, &skippedY))
+    {
+        return;
+    }
+
+    if (Bitmap_mode == GraphicsMode_4)
+    {
+        BitmapKernel_FillRect8(Bitmap_backBuffer + y * Bitmap_width + x, Bitmap_width, width, height, colour);
+    }
+    else
+    {
+        BitmapKernel_FillRect16((u16 *)Bitmap_backBuffer + y * Bitmap_width + x, Bitmap_width, width, height, colour);
+    }
+}
+
+void Bitmap_Blit(int x, int y, const void *pixels, int width, int height, int stride)
+{
+    int skippedX, skippedY;
+    if (!Bitmap_clipSpan(&x, &width, Bitmap_width, &skippedX) || !Bitmap_clipSpan(&y, &height, Bitmap_height, &skippedY))
+    {
+        return;
+    }
+
+    int sourceOffset = skippedY * stride + skippedX;
+
+    if (Bitmap_mode == GraphicsMode_4)
+    {
+        BitmapKernel_Blit8(Bitmap_backBuffer + y * Bitmap_width + x, Bitmap_width,
+                           (const u8 *)pixels + sourceOffset, stride, width, height);
+    }
+    else
+    {
+        BitmapKernel_Blit16((u16 *)Bitmap_backBuffer + y * Bitmap_width + x, Bitmap_width,
+                            (const u16 *)pixels + sourceOffset, stride, width, height);
+    }
+}
+
+// Narrows [*first, *last] to the i for which start + i * step is in [0, limit). All in 16.16 fixed point apart
+// from i
+static void Bitmap_clipLine(s32 start, s32 step, s32 limit, int *first, int *last)
+{
+    if (step < 0)
+    {
+        // Mirror so that the value goes up with i. It's in range exactly when the mirrored one is
+        start = limit - 1 - start;
+        step = -step;
+    }
+
+    if (step == 0)
+    {
+        if (start < 0 || start >= limit)
+        {
+            *last = *first - 1;
+        }
+        return;
+    }
+
+    if (start < 0)
+    {
+        int firstInside = (-start + step - 1) / step;
+        *first = firstInside > *first ? firstInside : *first;
+    }
+
+    if (start >= limit)
+    {
+        *last = *first - 1;
+        return;
+    }
+
+    int lastInside = (limit - 1 - start) / step;
+    *last = lastInside < *last ? lastInside : *last;
+}
+
+void Bitmap_DrawLine(int x0, int y0, int x1, int y1, u16 colour)
+{
+    if (y0 == y1)
+    {
+        Bitmap_FillSpan(x0 < x1 ? x0 : x1, y0, (x0 < x1 ? x1 - x0 : x0 - x1) + 1, colour);
+        return;
+    }
+
+    int deltaX = x1 - x0;
+    int deltaY = y1 - y0;
+    int absDeltaX = deltaX < 0 ? -deltaX : deltaX;
+    int absDeltaY = deltaY < 0 ? -deltaY : deltaY;
+    int major = absDeltaX > absDeltaY ? absDeltaX : absDeltaY;
+
+    // One of the steps is exactly 1 pixel, the other is at most 1. Start in the middle of the pixel so that
+    // truncating rounds to the nearest.
+    s32 stepX = major ? (deltaX << 16) / major : 0;
+    s32 stepY = major ? (deltaY << 16) / major : 0;
+    s32 x = (x0 << 16) + 0x8000;
+    s32 y = (y0 << 16) + 0x8000;
+
+    int first = 0;
+    int last = major;
+    Bitmap_clipLine(x, stepX, Bitmap_width << 16, &first, &last);
+    Bitmap_clipLine(y, stepY, Bitmap_height << 16, &first, &last);
+
+    if (first > last)
+    {
+        return;
+    }
+
+    x += first * stepX;
+    y += first * stepY;
+
+    if (Bitmap_mode == GraphicsMode_4)
+    {
+        BitmapKernel_Line8(Bitmap_backBuffer, Bitmap_width, x, y, stepX, stepY, last - first + 1, colour);
+    }
+    else
+    {
+        BitmapKernel_Line16((u16 *)Bitmap_backBuffer, Bitmap_width, x, y, stepX, stepY, last - first + 1, colour);
+    }
+}
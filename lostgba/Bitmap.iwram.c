@@ -0,0 +1,229 @@
+// The bitmap drawing loops. These touch every pixel they draw, so they are compiled as ARM code and run from IWRAM
+// (see the *.iwram.c rule in the Makefile). The only branches inside the loops are the loop conditions, all the
+// alignment fixing happens once per row.
+
+#include "BitmapInternal.h"
+#include "LostGbaInternal.h"
+
+static void BitmapKernel_fillRow16(u16 *destination, u32 colourPair, int width)
+{
+    if ((uintptr_t)destination & 2)
+    {
+        *destination++ = colourPair;
+        width--;
+    }
+
+    u32 *destination32 = (u32 *)destination;
+    for (int i = width >> 1; i > 0; i--)
+    {
+        *destination32++ = colourPair;
+    }
+
+    if (width & 1)
+    {
+        *(u16 *)destination32 = colourPair;
+    }
+}
+
+void BitmapKernel_FillRect16(u16 *topLeft, int pitch, int width, int height, u16 colour)
+{
+    u32 colourPair = colour | ((u32)colour << 16);
+
+    for (; height > 0; height--)
+    {
+        BitmapKernel_fillRow16(topLeft, colourPair, width);
+        topLeft += pitch;
+    }
+}
+
+// Writes the high byte of the halfword containing odd address destination
+static void BitmapKernel_setHighByte(u8 *destination, u32 value)
+{
+    u16 *halfword = (u16 *)(destination - 1);
+    *halfword = (*halfword & 0x00ff) | (value << 8);
+}
+
+// Writes the low byte of the halfword starting at even address destination
+static void BitmapKernel_setLowByte(u8 *destination, u32 value)
+{
+    u16 *halfword = (u16 *)destination;
+    *halfword = (*halfword & 0xff00) | (value & 0xff);
+}
+
+static void BitmapKernel_fillRow8(u8 *destination, u32 colourQuad, int width)
+{
+    if ((uintptr_t)destination & 1)
+    {
+        BitmapKernel_setHighByte(destination++, colourQuad & 0xff);
+        width--;
+    }
+
+    u16 *destination16 = (u16 *)destination;
+    if (width >= 2 && ((uintptr_t)destination16 & 2))
+    {
+        *destination16++ = colourQuad;
+        width -= 2;
+    }
+
+    u32 *destination32 = (u32 *)destination16;
+    for (int i = width >> 2; i > 0; i--)
+    {
+        *destination32++ = colourQuad;
+    }
+
+    destination16 = (u16 *)destination32;
+    if (width & 2)
+    {
+        *destination16++ = colourQuad;
+    }
+
+    if (width & 1)
+    {
+        BitmapKernel_setLowByte((u8 *)destination16, colourQuad);
+    }
+}
+
+void BitmapKernel_FillRect8(u8 *topLeft, int pitch, int width, int height, u8 colour)
+{
+    u32 colourQuad = colour * 0x01010101u;
+
+    for (; height > 0; height--)
+    {
+        BitmapKernel_fillRow8(topLeft, colourQuad, width);
+        topLeft += pitch;
+    }
+}
+
+static void BitmapKernel_blitRow16(u16 *destination, const u16 *source, int width)
+{
+    if ((uintptr_t)destination & 2)
+    {
+        *destination++ = *source++;
+        width--;
+    }
+
+    u32 *destination32 = (u32 *)destination;
+
+    if (((uintptr_t)source & 2) == 0)
+    {
+        const u32 *source32 = (const u32 *)source;
+        for (int i = width >> 1; i > 0; i--)
+        {
+            *destination32++ = *source32++;
+        }
+        source = (const u16 *)source32;
+    }
+    else
+    {
+        // The source is half a word out, so build each destination word from the top of one source word and the
+        // bottom of the next. Reads up to 2 bytes past the end of the row, but never outside the word holding
+        // its last pixel.
+        const u32 *source32 = (const u32 *)(source - 1);
+        u32 previous = *source32++;
+        for (int i = width >> 1; i > 0; i--)
+        {
+            u32 next = *source32++;
+            *destination32++ = (previous >> 16) | (next << 16);
+            previous = next;
+        }
+        source = (const u16 *)source32 - 1;
+    }
+
+    if (width & 1)
+    {
+        *(u16 *)destination32 = *source;
+    }
+}
+
+void BitmapKernel_Blit16(u16 *topLeft, int pitch, const u16 *pixels, int stride, int width, int height)
+{
+    for (; height > 0; height--)
+    {
+        BitmapKernel_blitRow16(topLeft, pixels, width);
+        topLeft += pitch;
+        pixels += stride;
+    }
+}
+
+static void BitmapKernel_blitRow8(u8 *destination, const u8 *source, int width)
+{
+    if ((uintptr_t)destination & 1)
+    {
+        BitmapKernel_setHighByte(destination++, *source++);
+        width--;
+    }
+
+    u16 *destination16 = (u16 *)destination;
+    if (width >= 2 && ((uintptr_t)destination16 & 2))
+    {
+        *destination16++ = source[0] | (source[1] << 8);
+        source += 2;
+        width -= 2;
+    }
+
+    u32 *destination32 = (u32 *)destination16;
+    if (((uintptr_t)source & 3) == 0)
+    {
+        const u32 *source32 = (const u32 *)source;
+        for (int i = width >> 2; i > 0; i--)
+        {
+            *destination32++ = *source32++;
+        }
+        source = (const u8 *)source32;
+    }
+    else
+    {
+        for (int i = width >> 2; i > 0; i--)
+        {
+            *destination32++ = source[0] | (source[1] << 8) | (source[2] << 16) | ((u32)source[3] << 24);
+            source += 4;
+        }
+    }
+
+    destination16 = (u16 *)destination32;
+    if (width & 2)
+    {
+        *destination16++ = source[0] | (source[1] << 8);
+        source += 2;
+    }
+
+    if (width & 1)
+    {
+        BitmapKernel_setLowByte((u8 *)destination16, *source);
+    }
+}
+
+void BitmapKernel_Blit8(u8 *topLeft, int pitch, const u8 *pixels, int stride, int width, int height)
+{
+    for (; height > 0; height--)
+    {
+        BitmapKernel_blitRow8(topLeft, pixels, width);
+        topLeft += pitch;
+        pixels += stride;
+    }
+}
+
+void BitmapKernel_Line16(u16 *pixels, int pitch, s32 x, s32 y, s32 stepX, s32 stepY, int count, u16 colour)
+{
+    for (; count > 0; count--)
+    {
+        pixels[(y >> 16) * pitch + (x >> 16)] = colour;
+        x += stepX;
+        y += stepY;
+    }
+}
+
+void BitmapKernel_Line8(u8 *pixels, int pitch, s32 x, s32 y, s32 stepX, s32 stepY, int count, u8 colour)
+{
+    for (; count > 0; count--)
+    {
+        // Which byte of the halfword to replace is worked out arithmetically rather than with a branch
+        u32 index = (y >> 16) * pitch + (x >> 16);
+        u16 *halfword = (u16 *)(pixels + (index & ~1u));
+        u32 shift = (index & 1) << 3;
+
+        *halfword = (*halfword & ~(0xffu << shift)) | ((u32)colour << shift);
+        x += stepX;
+        y += stepY;
+    }
+}
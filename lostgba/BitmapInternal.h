@@ -0,0 +1,20 @@
+/**
+ * @file BitmapInternal.h
+ */
+
+#pragma once
+
+#include <lostgba/GbaTypes.h>
+
+// The per row loops for Bitmap.h, in Bitmap.iwram.c. Everything passed in has already been clipped, widths and
+// heights are at least 1, and pitches are in pixels.
+
+void BitmapKernel_FillRect8(u8 *topLeft, int pitch, int width, int height, u8 colour);
+void BitmapKernel_FillRect16(u16 *topLeft, int pitch, int width, int height, u16 colour);
+
+void BitmapKernel_Blit8(u8 *topLeft, int pitch, const u8 *pixels, int stride, int width, int height);
+void BitmapKernel_Blit16(u16 *topLeft, int pitch, const u16 *pixels, int stride, int width, int height);
+
+// Plots count pixels starting at x, y and moving by stepX, stepY each time. All 4 are in 16.16 fixed point
+void BitmapKernel_Line8(u8 *pixels, int pitch, s32 x, s32 y, s32 stepX, s32 stepY, int count, u8 colour);
+void BitmapKernel_Line16(u16 *pixels, int pitch, s32 x, s32 y, s32 stepX, s32 stepY, int count, u16 colour);
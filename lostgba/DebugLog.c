@@ -0,0 +1,52 @@
+#include <lostgba/DebugLog.h>
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "LostGbaInternal.h"
+
+static vu16 *DebugLog_enableRegister = (vu16 *)LOSTGBA_ADDRESS(0x04FFF780);
+static vu16 *DebugLog_flagsRegister = (vu16 *)LOSTGBA_ADDRESS(0x04FFF700);
+static char *DebugLog_messageBuffer = (char *)LOSTGBA_ADDRESS(0x04FFF600);
+
+#define DEBUG_LOG_ENABLE_REQUEST 0xC0DE
+#define DEBUG_LOG_ENABLE_RESPONSE 0x1DEA
+#define DEBUG_LOG_SEND (1 << 8)
+
+static bool DebugLog_enabled = false;
+
+bool DebugLog_Init(void)
+{
+    *DebugLog_enableRegister = DEBUG_LOG_ENABLE_REQUEST;
+    DebugLog_enabled = *DebugLog_enableRegister == DEBUG_LOG_ENABLE_RESPONSE;
+
+    return DebugLog_enabled;
+}
+
+void DebugLog_Print(enum DebugLogLevel level, const char *message)
+{
+    if (!DebugLog_enabled)
+    {
+        return;
+    }
+
+    strncpy(DebugLog_messageBuffer, message, DebugLog_MaxMessageLength - 1);
+    DebugLog_messageBuffer[DebugLog_MaxMessageLength - 1] = '\0';
+    *DebugLog_flagsRegister = level | DEBUG_LOG_SEND;
+}
+
+void DebugLog_Printf(enum DebugLogLevel level, const char *format, ...)
+{
+    if (!DebugLog_enabled)
+    {
+        return;
+    }
+
+    va_list args;
+    va_start(args, format);
+    vsnprintf(DebugLog_messageBuffer, DebugLog_MaxMessageLength, format, args);
+    va_end(args);
+
+    *DebugLog_flagsRegister = level | DEBUG_LOG_SEND;
+}
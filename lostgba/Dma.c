@@ -0,0 +1,100 @@
+#include <lostgba/Dma.h>
+#include "LostGbaInternal.h"
+
+struct DmaRegisters
+{
+    vu32 source;
+    vu32 destination;
+    vu32 control; // count in the bottom 16 bits, control flags in the top 16 bits
+};
+
+static volatile struct DmaRegisters *Dma_registers = (volatile struct DmaRegisters *)LOSTGBA_ADDRESS(0x040000B0);
+
+#define DMA_ENABLE (1u << 15)
+
+static u16 Dma_makeControl(struct DmaSettings settings)
+{
+    return (settings.destinationControl << 5) |
+           (settings.sourceControl << 7) |
+           (settings.repeat << 9) |
+           (settings.chunkSize << 10) |
+           (settings.timing << 12) |
+           (settings.interruptOnFinish << 14) |
+           DMA_ENABLE;
+}
+
+static void Dma_transfer(enum DmaChannel channel, const volatile void *source, volatile void *destination, u32 count, u16 control)
+{
+#ifdef LOSTGBA_HOST
+    LostGBA_HostDmaTransfer(channel, source, destination, count, control);
+#else
+    volatile struct DmaRegisters *registers = &Dma_registers[channel];
+
+    // Clearing the enable bit first makes sure the new addresses get latched, even if a repeating
+    // transfer was running on this channel
+    registers->control = 0;
+    registers->source = (u32)source;
+    registers->destination = (u32)destination;
+    registers->control = (count & LostGBA_AllOnes16(16)) | ((u32)control << 16);
+#endif
+}
+
+void Dma_Start(enum DmaChannel channel, const volatile void *source, volatile void *destination, u32 count, struct DmaSettings settings)
+{
+    Dma_transfer(channel, source, destination, count, Dma_makeControl(settings));
+}
+
+void Dma_Stop(enum DmaChannel channel)
+{
+    Dma_registers[channel].control = 0;
+}
+
+bool Dma_IsRunning(enum DmaChannel channel)
+{
+    return Dma_registers[channel].control & (DMA_ENABLE << 16);
+}
+
+#define DMA_COPY16 (DMA_ENABLE)
+#define DMA_COPY32 (DMA_ENABLE | (DmaChunkSize_32 << 10))
+#define DMA_FILL16 (DMA_COPY16 | (DmaAddressControl_Fixed << 7))
+#define DMA_FILL32 (DMA_COPY32 | (DmaAddressControl_Fixed << 7))
+
+void Dma_Copy16(const void *source, volatile void *destination, u32 count)
+{
+    Dma_transfer(DmaChannel_3, source, destination, count, DMA_COPY16);
+}
+
+void Dma_Copy32(const void *source, volatile void *destination, u32 count)
+{
+    Dma_transfer(DmaChannel_3, source, destination, count, DMA_COPY32);
+}
+
+void Dma_Copy(const void *source, volatile void *destination, u32 length)
+{
+    u32 words = length / sizeof(u32);
+
+    if (words)
+    {
+        Dma_Copy32(source, destination, words);
+    }
+
+    if (length & 2)
+    {
+        Dma_Copy16((const u32 *)source + words, (volatile u32 *)destination + words, 1);
+    }
+}
+
+// The DMA needs something in memory to read the fill value from
+static vu32 Dma_fillValue;
+
+void Dma_Fill16(u16 value, volatile void *destination, u32 count)
+{
+    Dma_fillValue = value;
+    Dma_transfer(DmaChannel_3, &Dma_fillValue, destination, count, DMA_FILL16);
+}
+
+void Dma_Fill32(u32 value, volatile void *destination, u32 count)
+{
+    Dma_fillValue = value;
+    Dma_transfer(DmaChannel_3, &Dma_fillValue, destination, count, DMA_FILL32);
+}
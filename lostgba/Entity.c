@@ -0,0 +1,186 @@
+#include <lostgba/Entity.h>
+#include <lostgba/Graphics.h>
+
+#include <stddef.h>
+
+#include "EntityInternal.h"
+#include "LostGbaInternal.h"
+
+int entityCount = 0;
+
+Fixed16 entityX[Entity_MaxEntities];
+Fixed16 entityY[Entity_MaxEntities];
+Fixed16 entityVelocityX[Entity_MaxEntities];
+Fixed16 entityVelocityY[Entity_MaxEntities];
+
+u8 entityIndices[Entity_MaxEntities];
+u8 entityHandles[Entity_MaxEntities];
+struct ObjectAttribute *entityAttributes[Entity_MaxEntities];
+Fixed16 entityMaxX[Entity_MaxEntities];
+Fixed16 entityMaxY[Entity_MaxEntities];
+s8 entityOffsetX[Entity_MaxEntities];
+s8 entityOffsetY[Entity_MaxEntities];
+u8 entityFlags[Entity_MaxEntities];
+
+const struct AnimationClip *entityClips[Entity_MaxEntities];
+u16 entityFrameIndices[Entity_MaxEntities];
+u8 entityTicksLeft[Entity_MaxEntities];
+u16 entityBaseTiles[Entity_MaxEntities];
+
+// The sprite of each handle. Only needed when creating and destroying, so it is indexed by handle rather than kept
+// packed with everything else
+static u8 Entity_sprites[Entity_MaxEntities];
+
+// Free handles form a singly linked list through Entity_nextFree
+static u8 Entity_nextFree[Entity_MaxEntities];
+static int Entity_firstFree;
+
+// Sprite sizes in pixels, indexed by [shape][size]
+static const u8 Entity_spriteWidths[3][4] = {
+    {8, 16, 32, 64},
+    {16, 32, 32, 64},
+    {8, 8, 16, 32},
+};
+static const u8 Entity_spriteHeights[3][4] = {
+    {8, 16, 32, 64},
+    {8, 8, 16, 32},
+    {16, 32, 32, 64},
+};
+
+void Entity_Init(void)
+{
+    for (int i = 0; i < Entity_MaxEntities; i++)
+    {
+        Entity_nextFree[i] = i + 1;
+    }
+
+    Entity_firstFree = 0;
+    entityCount = 0;
+}
+
+EntityHandle Entity_Create(Fixed16 x, Fixed16 y, const struct ObjectAttributeDescriptor *sprite)
+{
+    if (Entity_firstFree == Entity_MaxEntities)
+    {
+        return Entity_InvalidHandle;
+    }
+
+    SpriteHandle spriteHandle = Sprite_Alloc();
+    if (spriteHandle == Sprite_InvalidHandle)
+    {
+        return Entity_InvalidHandle;
+    }
+
+    EntityHandle handle = Entity_firstFree;
+    Entity_firstFree = Entity_nextFree[handle];
+
+    int index = entityCount++;
+    entityIndices[handle] = index;
+    entityHandles[index] = handle;
+    Entity_sprites[handle] = spriteHandle;
+
+    struct ObjectAttribute *attr = Sprite_GetAttribute(spriteHandle);
+    ObjectAttribute_Build(attr, sprite);
+    entityAttributes[index] = attr;
+
+    entityX[index] = x;
+    entityY[index] = y;
+    entityVelocityX[index] = 0;
+    entityVelocityY[index] = 0;
+    entityMaxX[index] = Fixed16_FromInt(Graphics_ScreenWidth - Entity_spriteWidths[sprite->shape][sprite->size]);
+    entityMaxY[index] = Fixed16_FromInt(Graphics_ScreenHeight - Entity_spriteHeights[sprite->shape][sprite->size]);
+    entityOffsetX[index] = 0;
+    entityOffsetY[index] = 0;
+    entityFlags[index] = EntityEdgeMode_None;
+
+    entityClips[index] = NULL;
+    entityFrameIndices[index] = 0;
+    entityTicksLeft[index] = 0;
+    entityBaseTiles[index] = sprite->tileId;
+
+    return handle;
+}
+
+void Entity_Destroy(EntityHandle handle)
+{
+    Sprite_Free(Entity_sprites[handle]);
+
+    // Move the last entity into the gap so the arrays stay packed
+    int index = entityIndices[handle];
+    int last = --entityCount;
+
+    int lastHandle = entityHandles[last];
+    entityHandles[index] = lastHandle;
+    entityIndices[lastHandle] = index;
+
+    entityX[index] = entityX[last];
+    entityY[index] = entityY[last];
+    entityVelocityX[index] = entityVelocityX[last];
+    entityVelocityY[index] = entityVelocityY[last];
+    entityAttributes[index] = entityAttributes[last];
+    entityMaxX[index] = entityMaxX[last];
+    entityMaxY[index] = entityMaxY[last];
+    entityOffsetX[index] = entityOffsetX[last];
+    entityOffsetY[index] = entityOffsetY[last];
+    entityFlags[index] = entityFlags[last];
+    entityClips[index] = entityClips[last];
+    entityFrameIndices[index] = entityFrameIndices[last];
+    entityTicksLeft[index] = entityTicksLeft[last];
+    entityBaseTiles[index] = entityBaseTiles[last];
+
+    Entity_nextFree[handle] = Entity_firstFree;
+    Entity_firstFree = handle;
+}
+
+SpriteHandle Entity_GetSprite(EntityHandle handle)
+{
+    return Entity_sprites[handle];
+}
+
+void Entity_SetEdgeMode(EntityHandle handle, enum EntityEdgeMode edgeMode)
+{
+    int index = Entity_Index(handle);
+    entityFlags[index] = (entityFlags[index] & ~EntityFlag_EdgeModeMask) | edgeMode;
+}
+
+void Entity_SetOffset(EntityHandle handle, int offsetX, int offsetY)
+{
+    int index = Entity_Index(handle);
+    entityOffsetX[index] = offsetX;
+    entityOffsetY[index] = offsetY;
+}
+
+void Entity_Play(EntityHandle handle, const struct AnimationClip *clip)
+{
+    int index = Entity_Index(handle);
+    if (entityClips[index] == clip)
+    {
+        return;
+    }
+
+    entityClips[index] = clip;
+    entityFrameIndices[index] = 0;
+    entityFlags[index] &= ~EntityFlag_AnimationFinished;
+
+    if (clip)
+    {
+        EntityKernel_ShowFrame(index);
+    }
+    else
+    {
+        entityTicksLeft[index] = 0;
+    }
+}
+
+bool Entity_IsAnimationFinished(EntityHandle handle)
+{
+    return entityFlags[Entity_Index(handle)] & EntityFlag_AnimationFinished;
+}
+
+void Entity_UpdateAll(void)
+{
+    Entity_Animate();
+    Entity_Integrate();
+    Entity_ApplyEdges();
+    Entity_WriteSprites();
+}
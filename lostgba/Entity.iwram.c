@@ -0,0 +1,135 @@
+// The entity update passes. Each one runs over every entity every frame, so they are compiled as ARM code and run
+// from IWRAM (see the *.iwram.c rule in the Makefile).
+
+#include <stddef.h>
+
+#include "EntityInternal.h"
+#include "LostGbaInternal.h"
+
+void EntityKernel_ShowFrame(int index)
+{
+    const struct AnimationFrame *frame = &entityClips[index]->frames[entityFrameIndices[index]];
+
+    entityTicksLeft[index] = frame->duration;
+    entityOffsetX[index] = frame->offsetX;
+    entityOffsetY[index] = frame->offsetY;
+
+    struct ObjectAttribute *attr = entityAttributes[index];
+    ObjectAttribute_SetTile(attr, entityBaseTiles[index] + frame->tile);
+    ObjectAttribute_SetHFlip(attr, frame->flags & AnimationFrameFlag_HFlip);
+    ObjectAttribute_SetVFlip(attr, frame->flags & AnimationFrameFlag_VFlip);
+}
+
+void Entity_Animate(void)
+{
+    int count = entityCount;
+    for (int i = 0; i < count; i++)
+    {
+        // Most entities are part way through a frame (or not animated at all), so keep that path as short as
+        // possible
+        int ticksLeft = entityTicksLeft[i];
+        if (ticksLeft > 1)
+        {
+            entityTicksLeft[i] = ticksLeft - 1;
+            continue;
+        }
+
+        const struct AnimationClip *clip = entityClips[i];
+        if (!clip || (entityFlags[i] & EntityFlag_AnimationFinished))
+        {
+            continue;
+        }
+
+        int nextFrame = entityFrameIndices[i] + 1;
+        if (nextFrame == clip->frameCount)
+        {
+            if (clip->loopMode == AnimationLoopMode_Once)
+            {
+                entityTicksLeft[i] = 0;
+                entityFlags[i] |= EntityFlag_AnimationFinished;
+                continue;
+            }
+
+            nextFrame = 0;
+        }
+
+        // Clips with a single looping frame never need anything changing
+        if (nextFrame == entityFrameIndices[i])
+        {
+            entityTicksLeft[i] = clip->frames[nextFrame].duration;
+            continue;
+        }
+
+        entityFrameIndices[i] = nextFrame;
+        EntityKernel_ShowFrame(i);
+    }
+}
+
+void Entity_Integrate(void)
+{
+    int count = entityCount;
+    for (int i = 0; i < count; i++)
+    {
+        entityX[i] += entityVelocityX[i];
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        entityY[i] += entityVelocityY[i];
+    }
+}
+
+// Keeps *position in [0, max]. Returns the new velocity
+static inline Fixed16 Entity_applyEdge(Fixed16 *position, Fixed16 velocity, Fixed16 max, int edgeMode)
+{
+    if (*position < 0)
+    {
+        *position = 0;
+        if (velocity < 0)
+        {
+            velocity = edgeMode == EntityEdgeMode_Bounce ? -velocity : 0;
+        }
+    }
+    else if (*position > max)
+    {
+        *position = max;
+        if (velocity > 0)
+        {
+            velocity = edgeMode == EntityEdgeMode_Bounce ? -velocity : 0;
+        }
+    }
+
+    return velocity;
+}
+
+void Entity_ApplyEdges(void)
+{
+    int count = entityCount;
+    for (int i = 0; i < count; i++)
+    {
+        int edgeMode = entityFlags[i] & EntityFlag_EdgeModeMask;
+        if (edgeMode == EntityEdgeMode_None)
+        {
+            continue;
+        }
+
+        entityVelocityX[i] = Entity_applyEdge(&entityX[i], entityVelocityX[i], entityMaxX[i], edgeMode);
+        entityVelocityY[i] = Entity_applyEdge(&entityY[i], entityVelocityY[i], entityMaxY[i], edgeMode);
+    }
+}
+
+void Entity_WriteSprites(void)
+{
+    // The sprite attributes aren't in objectAttributeBuffer, so there is nothing to mark dirty. Sprite_Commit()
+    // works out what changed
+    int count = entityCount;
+    for (int i = 0; i < count; i++)
+    {
+        struct ObjectAttribute *attr = entityAttributes[i];
+        int x = Fixed16_ToInt(entityX[i]) + entityOffsetX[i];
+        int y = Fixed16_ToInt(entityY[i]) + entityOffsetY[i];
+
+        attr->attr0 = (attr->attr0 & ~0xff) | (y & 0xff);
+        attr->attr1 = (attr->attr1 & ~0x1ff) | (x & 0x1ff);
+    }
+}
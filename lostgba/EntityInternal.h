@@ -0,0 +1,41 @@
+/**
+ * @file EntityInternal.h
+ */
+
+#pragma once
+
+#include <lostgba/Entity.h>
+
+/** Bits of entityFlags */
+enum EntityFlag
+{
+    /** The low 2 bits are an EntityEdgeMode */
+    EntityFlag_EdgeModeMask = 3,
+    /** The animation has reached the end of its last frame */
+    EntityFlag_AnimationFinished = 1 << 2,
+};
+
+// The rest of the per entity arrays, indexed the same way as entityX. Shared between Entity.c and the passes in
+// Entity.iwram.c
+
+/** The handle of each entity */
+extern u8 entityHandles[Entity_MaxEntities];
+/** The attributes of each entity's sprite, from Sprite_GetAttribute() */
+extern struct ObjectAttribute *entityAttributes[Entity_MaxEntities];
+/** The furthest right and down each entity can go while staying on screen */
+extern Fixed16 entityMaxX[Entity_MaxEntities];
+extern Fixed16 entityMaxY[Entity_MaxEntities];
+extern s8 entityOffsetX[Entity_MaxEntities];
+extern s8 entityOffsetY[Entity_MaxEntities];
+/** A combination of EntityFlag values */
+extern u8 entityFlags[Entity_MaxEntities];
+
+extern const struct AnimationClip *entityClips[Entity_MaxEntities];
+extern u16 entityFrameIndices[Entity_MaxEntities];
+/** Ticks left until the next frame */
+extern u8 entityTicksLeft[Entity_MaxEntities];
+/** The tile the entity was created with, which frame tiles are added to */
+extern u16 entityBaseTiles[Entity_MaxEntities];
+
+/** Shows the current frame of the entity at @p index */
+void EntityKernel_ShowFrame(int index);
@@ -0,0 +1,136 @@
+#include <lostgba/Fixed.h>
+#include <lostgba/SystemCalls.h>
+
+#include "LostGbaInternal.h"
+
+// numerator / denominator rounded to nearest rather than towards zero. Division truncates, so push the numerator
+// half a denominator further away from zero first
+static s32 Fixed_divRound(s32 numerator, s32 denominator)
+{
+    s32 half = (denominator < 0 ? -denominator : denominator) / 2;
+    numerator += numerator < 0 ? -half : half;
+
+    return SystemCall_Div(numerator, denominator);
+}
+
+Fixed8 Fixed8_Div(Fixed8 a, Fixed8 b)
+{
+    return Fixed_divRound((s32)a << 8, b);
+}
+
+Fixed16 Fixed16_Div(Fixed16 a, Fixed16 b)
+{
+    s64 numerator = (s64)a << 16;
+    s64 half = (b < 0 ? -(s64)b : b) / 2;
+    numerator += numerator < 0 ? -half : half;
+
+    return numerator / b;
+}
+
+Fixed16 Fixed16_ReciprocalInt(int value)
+{
+    if (value == 1)
+    {
+        return Fixed16_One;
+    }
+
+    // The table is 0.32
+    return (LostGBA_ReciprocalTable[value] + (1u << 15)) >> 16;
+}
+
+Fixed16 Fixed16_DivInt(Fixed16 a, int divisor)
+{
+    int magnitude = divisor < 0 ? -divisor : divisor;
+
+    if (magnitude >= LostGBA_ReciprocalTableLength)
+    {
+        return Fixed_divRound(a, divisor);
+    }
+
+    Fixed16 result = a;
+    if (magnitude != 1)
+    {
+        result = ((s64)a * LostGBA_ReciprocalTable[magnitude] + (1u << 31)) >> 32;
+    }
+
+    return divisor < 0 ? -result : result;
+}
+
+#define FIXED_ANGLE_SHIFT 7 // Fixed_FullTurn steps in a turn down to LostGBA_SineTableLength
+#define FIXED_QUARTER_TURN (Fixed_FullTurn / 4)
+
+Fixed16 Fixed16_Sin(u16 angle)
+{
+    // The table is 4.12
+    return (s32)LostGBA_SineTable[angle >> FIXED_ANGLE_SHIFT] << 4;
+}
+
+Fixed16 Fixed16_Cos(u16 angle)
+{
+    return Fixed16_Sin(angle + FIXED_QUARTER_TURN);
+}
+
+u16 Fixed_ArcTan2(s32 y, s32 x)
+{
+    if (x == 0 && y == 0)
+    {
+        return 0;
+    }
+
+    u32 absX = x < 0 ? -(u32)x : (u32)x;
+    u32 absY = y < 0 ? -(u32)y : (u32)y;
+
+    // The ratio is worked out to the nearest 1 / 256, so keep the numerator from overflowing when it is shifted up
+    while ((absX | absY) >= (1u << 23))
+    {
+        absX >>= 1;
+        absY >>= 1;
+    }
+
+    // Work out the angle in the first octant, then reflect it into the right place
+    u32 angle;
+    if (absY <= absX)
+    {
+        angle = LostGBA_ArcTanTable[SystemCall_Div((absY << 8) + absX / 2, absX)];
+    }
+    else
+    {
+        angle = FIXED_QUARTER_TURN - LostGBA_ArcTanTable[SystemCall_Div((absX << 8) + absY / 2, absY)];
+    }
+
+    if (x < 0)
+    {
+        angle = Fixed_FullTurn / 2 - angle;
+    }
+
+    if (y < 0)
+    {
+        angle = Fixed_FullTurn - angle;
+    }
+
+    return angle;
+}
+
+IWRAM_CODE ARM_TARGET void Fixed16_Integrate(Fixed16 *positions, const Fixed16 *velocities, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        positions[i] += velocities[i];
+    }
+}
+
+IWRAM_CODE ARM_TARGET void Fixed16_IntegrateScaled(Fixed16 *positions, const Fixed16 *velocities, Fixed16 scale, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        positions[i] += Fixed16_Mul(velocities[i], scale);
+    }
+}
+
+IWRAM_CODE ARM_TARGET void Fixed16_ScaleArray(Fixed16 *values, Fixed16 scale, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        values[i] = Fixed16_Mul(values[i], scale);
+    }
+}
@@ -0,0 +1,85 @@
+#include "LostGbaInternal.h"
+
+// atan(i / 256) where 0x10000 is a full turn
+const u16 LostGBA_ArcTanTable[LostGBA_ArcTanTableLength] = {
+    0, 41, 81, 122, 163, 204, 244, 285,
+    326, 367, 407, 448, 489, 529, 570, 610,
+    651, 692, 732, 773, 813, 854, 894, 935,
+    975, 1015, 1056, 1096, 1136, 1177, 1217, 1257,
+    1297, 1337, 1377, 1417, 1457, 1497, 1537, 1577,
+    1617, 1656, 1696, 1736, 1775, 1815, 1854, 1894,
+    1933, 1973, 2012, 2051, 2090, 2129, 2168, 2207,
+    2246, 2285, 2324, 2363, 2401, 2440, 2478, 2517,
+    2555, 2594, 2632, 2670, 2708, 2746, 2784, 2822,
+    2860, 2897, 2935, 2973, 3010, 3047, 3085, 3122,
+    3159, 3196, 3233, 3270, 3307, 3344, 3380, 3417,
+    3453, 3490, 3526, 3562, 3599, 3635, 3670, 3706,
+    3742, 3778, 3813, 3849, 3884, 3920, 3955, 3990,
+    4025, 4060, 4095, 4129, 4164, 4199, 4233, 4267,
+    4302, 4336, 4370, 4404, 4438, 4471, 4505, 4539,
+    4572, 4605, 4639, 4672, 4705, 4738, 4771, 4803,
+    4836, 4869, 4901, 4933, 4966, 4998, 5030, 5062,
+    5094, 5125, 5157, 5188, 5220, 5251, 5282, 5313,
+    5344, 5375, 5406, 5437, 5467, 5498, 5528, 5559,
+    5589, 5619, 5649, 5679, 5708, 5738, 5768, 5797,
+    5826, 5856, 5885, 5914, 5943, 5972, 6000, 6029,
+    6058, 6086, 6114, 6142, 6171, 6199, 6227, 6254,
+    6282, 6310, 6337, 6365, 6392, 6419, 6446, 6473,
+    6500, 6527, 6554, 6580, 6607, 6633, 6660, 6686,
+    6712, 6738, 6764, 6790, 6815, 6841, 6867, 6892,
+    6917, 6943, 6968, 6993, 7018, 7043, 7068, 7092,
+    7117, 7141, 7166, 7190, 7214, 7238, 7262, 7286,
+    7310, 7334, 7358, 7381, 7405, 7428, 7451, 7475,
+    7498, 7521, 7544, 7566, 7589, 7612, 7635, 7657,
+    7679, 7702, 7724, 7746, 7768, 7790, 7812, 7834,
+    7856, 7877, 7899, 7920, 7942, 7963, 7984, 8005,
+    8026, 8047, 8068, 8089, 8110, 8131, 8151, 8172,
+    8192,
+};
+
+// 2^32 / i rounded to nearest, so 1 / i in 0.32 fixed point. Entries 0 and 1 don't fit so are unused
+const u32 LostGBA_ReciprocalTable[LostGBA_ReciprocalTableLength] = {
+    0x00000000, 0x00000000, 0x80000000, 0x55555555, 0x40000000, 0x33333333,
+    0x2aaaaaab, 0x24924925, 0x20000000, 0x1c71c71c, 0x1999999a, 0x1745d174,
+    0x15555555, 0x13b13b14, 0x12492492, 0x11111111, 0x10000000, 0x0f0f0f0f,
+    0x0e38e38e, 0x0d79435e, 0x0ccccccd, 0x0c30c30c, 0x0ba2e8ba, 0x0b21642d,
+    0x0aaaaaab, 0x0a3d70a4, 0x09d89d8a, 0x097b425f, 0x09249249, 0x08d3dcb1,
+    0x08888889, 0x08421084, 0x08000000, 0x07c1f07c, 0x07878788, 0x07507507,
+    0x071c71c7, 0x06eb3e45, 0x06bca1af, 0x06906907, 0x06666666, 0x063e7064,
+    0x06186186, 0x05f417d0, 0x05d1745d, 0x05b05b06, 0x0590b216, 0x0572620b,
+    0x05555555, 0x0539782a, 0x051eb852, 0x05050505, 0x04ec4ec5, 0x04d4873f,
+    0x04bda12f, 0x04a7904a, 0x04924925, 0x047dc11f, 0x0469ee58, 0x0456c798,
+    0x04444444, 0x04325c54, 0x04210842, 0x04104104, 0x04000000, 0x03f03f04,
+    0x03e0f83e, 0x03d22635, 0x03c3c3c4, 0x03b5cc0f, 0x03a83a84, 0x039b0ad1,
+    0x038e38e4, 0x0381c0e0, 0x03759f23, 0x0369d037, 0x035e50d8, 0x03531dec,
+    0x03483483, 0x033d91d3, 0x03333333, 0x03291620, 0x031f3832, 0x03159722,
+    0x030c30c3, 0x03030303, 0x02fa0be8, 0x02f14990, 0x02e8ba2f, 0x02e05c0c,
+    0x02d82d83, 0x02d02d03, 0x02c8590b, 0x02c0b02c, 0x02b93105, 0x02b1da46,
+    0x02aaaaab, 0x02a3a0fd, 0x029cbc15, 0x0295fad4, 0x028f5c29, 0x0288df0d,
+    0x02828283, 0x027c4598, 0x02762762, 0x02702702, 0x026a439f, 0x02647c69,
+    0x025ed098, 0x02593f6a, 0x0253c825, 0x024e6a17, 0x02492492, 0x0243f6f0,
+    0x023ee090, 0x0239e0d6, 0x0234f72c, 0x02302302, 0x022b63cc, 0x0226b902,
+    0x02222222, 0x021d9ead, 0x02192e2a, 0x0214d021, 0x02108421, 0x020c49ba,
+    0x02082082, 0x02040810, 0x02000000, 0x01fc07f0, 0x01f81f82, 0x01f4465a,
+    0x01f07c1f, 0x01ecc07b, 0x01e9131b, 0x01e573ad, 0x01e1e1e2, 0x01de5d6e,
+    0x01dae607, 0x01d77b65, 0x01d41d42, 0x01d0cb59, 0x01cd8569, 0x01ca4b30,
+    0x01c71c72, 0x01c3f8f0, 0x01c0e070, 0x01bdd2b9, 0x01bacf91, 0x01b7d6c4,
+    0x01b4e81b, 0x01b20364, 0x01af286c, 0x01ac5702, 0x01a98ef6, 0x01a6d01a,
+    0x01a41a42, 0x01a16d40, 0x019ec8e9, 0x019c2d15, 0x0199999a, 0x01970e50,
+    0x01948b10, 0x01920fb5, 0x018f9c19, 0x018d3019, 0x018acb91, 0x01886e5f,
+    0x01861862, 0x0183c978, 0x01818182, 0x017f4060, 0x017d05f4, 0x017ad221,
+    0x0178a4c8, 0x01767dce, 0x01745d17, 0x01724288, 0x01702e06, 0x016e1f77,
+    0x016c16c1, 0x016a13cd, 0x01681681, 0x01661ec7, 0x01642c86, 0x01623fa7,
+    0x01605816, 0x015e75bc, 0x015c9883, 0x015ac057, 0x0158ed23, 0x01571ed4,
+    0x01555555, 0x01539095, 0x0151d07f, 0x01501501, 0x014e5e0a, 0x014cab88,
+    0x014afd6a, 0x0149539e, 0x0147ae14, 0x01460cbc, 0x01446f86, 0x0142d662,
+    0x01414141, 0x013fb014, 0x013e22cc, 0x013c995a, 0x013b13b1, 0x013991c3,
+    0x01381381, 0x013698df, 0x013521d0, 0x0133ae46, 0x01323e35, 0x0130d190,
+    0x012f684c, 0x012e025c, 0x012c9fb5, 0x012b404b, 0x0129e413, 0x01288b01,
+    0x0127350c, 0x0125e227, 0x01249249, 0x01234568, 0x0121fb78, 0x0120b471,
+    0x011f7048, 0x011e2ef4, 0x011cf06b, 0x011bb4a4, 0x011a7b96, 0x01194538,
+    0x01181181, 0x0116e069, 0x0115b1e6, 0x011485f1, 0x01135c81, 0x0112358e,
+    0x01111111, 0x010fef01, 0x010ecf57, 0x010db20b, 0x010c9715, 0x010b7e6f,
+    0x010a6811, 0x010953f4, 0x01084211, 0x01073261, 0x010624dd, 0x0105197f,
+    0x01041041, 0x0103091b, 0x01020408, 0x01010101, 0x01000000,
+};
@@ -1,7 +1,7 @@
 #include <lostgba/Graphics.h>
 #include "LostGbaInternal.h"
 
-static vu16 *Graphics_displayControlRegister = (vu16 *)0x04000000;
+static vu16 *Graphics_displayControlRegister = (vu16 *)LOSTGBA_ADDRESS(0x04000000);
 
 void Graphics_SetMode(struct GraphicsSettings settings)
 {
@@ -18,9 +18,38 @@ void Graphics_SetMode(struct GraphicsSettings settings)
     *Graphics_displayControlRegister = mode;
 }
 
-static vu16 *Graphics_displayStatusRegister = (vu16 *)0x04000004;
+#define GRAPHICS_FRAME_SELECT (1 << 4)
+
+void Graphics_SetDisplayedFrame(int frame)
+{
+    u16 displayControl = *Graphics_displayControlRegister & ~GRAPHICS_FRAME_SELECT;
+    *Graphics_displayControlRegister = displayControl | (frame ? GRAPHICS_FRAME_SELECT : 0);
+}
+
+static vu16 *Graphics_displayStatusRegister = (vu16 *)LOSTGBA_ADDRESS(0x04000004);
+
+static void Graphics_setDisplayStatusBits(u16 value, u16 length, u16 shift)
+{
+    u16 mask = LostGBA_AllOnes16(length) << shift;
+    *Graphics_displayStatusRegister = (*Graphics_displayStatusRegister & ~mask) | ((value << shift) & mask);
+}
 
 void Graphics_SetVBlankInterrupt(bool enabled)
 {
-    *Graphics_displayStatusRegister |= enabled << 3;
+    Graphics_setDisplayStatusBits(enabled, 1, 3);
+}
+
+void Graphics_SetHBlankInterrupt(bool enabled)
+{
+    Graphics_setDisplayStatusBits(enabled, 1, 4);
+}
+
+void Graphics_SetVCountInterrupt(bool enabled)
+{
+    Graphics_setDisplayStatusBits(enabled, 1, 5);
+}
+
+void Graphics_SetVCountTrigger(int line)
+{
+    Graphics_setDisplayStatusBits(line, 8, 8);
 }
\ No newline at end of file
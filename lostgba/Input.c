@@ -1,16 +1,93 @@
 #include <lostgba/Input.h>
+#include <lostgba/Interrupt.h>
+#include "LostGbaInternal.h"
 
 // Note that the GBA has a 1 at the bit position for not pressed and 0 for pressed
-vu16 *Input_keyInputRegister = (vu16 *)0x04000130;
+vu16 *Input_keyInputRegister = (vu16 *)LOSTGBA_ADDRESS(0x04000130);
 
-// These buffers store ~Input_keyInputRegister to make checking pressed state sane
-static u16 Input_previousKeyBuffer = 0;
+#define INPUT_KEY_COUNT 10
+#define INPUT_HISTORY_MASK (Input_HistoryLength - 1)
+
+// Each sample stores ~Input_keyInputRegister to make checking pressed state sane. Written by the VBlank handler
+// if VBlank sampling is enabled, so the count is only increased once the sample is in place
+static u16 Input_history[Input_HistoryLength];
+static volatile u32 Input_sampleCount = 0;
+static bool Input_vblankSampling = false;
+
+// The answers as of the last Input_UpdateKeyState()
+static u32 Input_consumedCount = 0;
 static u16 Input_keyBuffer = 0;
+static u16 Input_newlyPressed = 0;
+static u16 Input_newlyReleased = 0;
+static int Input_laggedFrames = 0;
+static u16 Input_heldFrames[INPUT_KEY_COUNT];
+// What Input_heldFrames was before the samples taken in by the last update, or 0 if the key was released among them
+static u16 Input_previousHeldFrames[INPUT_KEY_COUNT];
+
+static void Input_sample(void)
+{
+    u32 count = Input_sampleCount;
+    // Only the low INPUT_KEY_COUNT bits are keys, so the unused top bits mustn't read as held
+    Input_history[count & INPUT_HISTORY_MASK] = ~(*Input_keyInputRegister) & LostGBA_AllOnes16(INPUT_KEY_COUNT);
+    Input_sampleCount = count + 1;
+}
+
+void Input_EnableVBlankSampling(void)
+{
+    Input_vblankSampling = true;
+    Interrupt_AddHandler(InterruptType_VBlank, Input_sample, 0);
+}
 
 void Input_UpdateKeyState(void)
 {
-    Input_previousKeyBuffer = Input_keyBuffer;
-    Input_keyBuffer = ~(*Input_keyInputRegister);
+    if (!Input_vblankSampling)
+    {
+        Input_sample();
+    }
+
+    u32 count = Input_sampleCount;
+
+    // Anything older than the history has been overwritten
+    u32 first = Input_consumedCount;
+    if (count - first >= Input_HistoryLength)
+    {
+        first = count - (Input_HistoryLength - 1);
+    }
+
+    Input_newlyPressed = 0;
+    Input_newlyReleased = 0;
+    Input_laggedFrames = count - Input_consumedCount > 1 ? count - Input_consumedCount - 1 : 0;
+
+    for (int key = 0; key < INPUT_KEY_COUNT; key++)
+    {
+        Input_previousHeldFrames[key] = Input_heldFrames[key];
+    }
+
+    u16 keys = Input_keyBuffer;
+    for (u32 i = first; i != count; i++)
+    {
+        u16 sample = Input_history[i & INPUT_HISTORY_MASK];
+
+        Input_newlyPressed |= sample & ~keys;
+        Input_newlyReleased |= keys & ~sample;
+        keys = sample;
+
+        for (int key = 0; key < INPUT_KEY_COUNT; key++)
+        {
+            if (keys & (1 << key))
+            {
+                Input_heldFrames[key]++;
+            }
+            else
+            {
+                Input_heldFrames[key] = 0;
+                Input_previousHeldFrames[key] = 0;
+            }
+        }
+    }
+
+    Input_keyBuffer = keys;
+    Input_consumedCount = count;
 }
 
 bool Input_IsKeyDown(enum InputKey key)
@@ -19,7 +96,101 @@ bool Input_IsKeyDown(enum InputKey key)
 }
 
 bool Input_IsNewlyPressed(enum InputKey key)
+{
+    return Input_newlyPressed & (1 << key);
+}
+
+bool Input_IsNewlyReleased(enum InputKey key)
+{
+    return Input_newlyReleased & (1 << key);
+}
+
+u16 Input_NewlyPressedKeys(void)
+{
+    return Input_newlyPressed;
+}
+
+u16 Input_NewlyReleasedKeys(void)
+{
+    return Input_newlyReleased;
+}
+
+int Input_LaggedFrames(void)
+{
+    return Input_laggedFrames;
+}
+
+int Input_HeldFrames(enum InputKey key)
+{
+    return Input_heldFrames[key];
+}
+
+bool Input_WasPressedWithin(enum InputKey key, int frames)
 {
     u16 keyMask = 1 << key;
-    return !(Input_previousKeyBuffer & keyMask) && (Input_keyBuffer & keyMask);
-}
\ No newline at end of file
+    u32 newest = Input_consumedCount - 1;
+
+    // The VBlank handler may already be writing over the oldest half of the history
+    if (frames > Input_HistoryLength / 2)
+    {
+        frames = Input_HistoryLength / 2;
+    }
+
+    // Only look at samples which have been taken in, so the answer matches Input_IsKeyDown() and friends
+    for (int i = 0; i < frames && (u32)i + 1 < Input_consumedCount; i++)
+    {
+        u16 sample = Input_history[(newest - i) & INPUT_HISTORY_MASK];
+        u16 previous = Input_history[(newest - i - 1) & INPUT_HISTORY_MASK];
+
+        if (sample & ~previous & keyMask)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool Input_IsRepeating(enum InputKey key, int delay, int interval)
+{
+    if (Input_IsNewlyPressed(key))
+    {
+        return true;
+    }
+
+    // Without a sensible interval there is nothing to repeat, and the division below would divide by zero
+    if (interval <= 0)
+    {
+        return false;
+    }
+
+    // Repeat if any of the held counts reached by the samples taken in this update, (previous, held], is on the
+    // schedule. Nothing is repeated twice when no new samples came in, and a lagged frame can't skip past a repeat
+    int held = Input_heldFrames[key];
+    int first = Input_previousHeldFrames[key] + 1;
+    if (first < delay)
+    {
+        first = delay;
+    }
+
+    if (first > held)
+    {
+        return false;
+    }
+
+    int nextRepeat = delay + (first - delay + interval - 1) / interval * interval;
+    return nextRepeat <= held;
+}
+
+static vu16 *Input_keyControlRegister = (vu16 *)LOSTGBA_ADDRESS(0x04000132);
+
+void Input_SetInterruptKeys(u16 keyMask, bool requireAll)
+{
+    u16 interruptEnabled = *Input_keyControlRegister & (1 << 14);
+    *Input_keyControlRegister = (keyMask & LostGBA_AllOnes16(INPUT_KEY_COUNT)) | interruptEnabled | (requireAll << 15);
+}
+
+void Input_SetInterruptEnabled(bool enabled)
+{
+    *Input_keyControlRegister = (*Input_keyControlRegister & ~(1 << 14)) | (enabled << 14);
+}
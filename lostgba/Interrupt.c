@@ -1,24 +1,94 @@
 #include <lostgba/Interrupt.h>
 #include <lostgba/Graphics.h>
+#include <lostgba/Input.h>
+#include <lostgba/Timer.h>
 
 #include "LostGbaInternal.h"
 
-static vu16 *Interrupt_enabledInterrupts = (vu16 *)0x04000200;          // REG_IE
-static vu16 *Interrupt_acknowledgedInterrupts = (vu16 *)0x04000202;     // REG_IF
-static vu16 *Interrupt_acknowledgedInterruptsBios = (vu16 *)0x03007ff8; // REG_IFBIOS
-static vu16 *Interrupt_shouldThereBeInterrupts = (vu16 *)0x04000208;    // REG_IME
+static vu16 *Interrupt_enabledInterrupts = (vu16 *)LOSTGBA_ADDRESS(0x04000200);          // REG_IE
+static vu16 *Interrupt_acknowledgedInterrupts = (vu16 *)LOSTGBA_ADDRESS(0x04000202);     // REG_IF
+static vu16 *Interrupt_acknowledgedInterruptsBios = (vu16 *)LOSTGBA_ADDRESS(0x03007ff8); // REG_IFBIOS
+static vu16 *Interrupt_shouldThereBeInterrupts = (vu16 *)LOSTGBA_ADDRESS(0x04000208);    // REG_IME
 
 typedef void (*voidFnPtr)(void);
+#ifdef LOSTGBA_HOST
+// A host function pointer doesn't fit in the 4 bytes the BIOS reads it from, so it is kept separately
+static voidFnPtr *Interrupt_isrMainRegister = &LostGBA_hostInterruptServiceRoutine;
+#else
 static voidFnPtr *Interrupt_isrMainRegister = (voidFnPtr *)0x03007ffc;
+#endif
 
-IWRAM_CODE ARM_TARGET static void Interrupt_interruptServiceRoutineMain(void)
+struct InterruptHandlerEntry
 {
-    u32 irqs = *Interrupt_enabledInterrupts & *Interrupt_acknowledgedInterrupts;
+    u16 mask;
+    int priority;
+    InterruptHandler handler;
+};
+
+// Kept sorted by priority so the service routine can just walk it in order
+static struct InterruptHandlerEntry Interrupt_handlers[Interrupt_MaxHandlers];
+static int Interrupt_handlerCount = 0;
+static u16 Interrupt_nestableMask = 0;
 
-    // Do something clever with them
+// Calls handler in system mode with IRQs enabled, so that other interrupts can fire while it runs.
+// The BIOS doesn't save spsr_irq, and a nested interrupt would overwrite it and lr_irq, so both are saved on the
+// IRQ stack first. lr_sys belongs to whatever code got interrupted, so that is saved on the user stack.
+IWRAM_CODE ARM_TARGET static void Interrupt_callNested(InterruptHandler handler)
+{
+#ifdef LOSTGBA_HOST
+    // Interrupts are only ever raised by calling Host_RaiseInterrupt(), so nothing can actually nest
+    handler();
+#else
+    asm volatile(
+        "mrs r2, spsr\n\t"
+        "stmfd sp!, {r2, lr}\n\t"
+        "mrs r3, cpsr\n\t"
+        "bic r3, r3, #0xdf\n\t"
+        "orr r3, r3, #0x1f\n\t" // system mode, IRQs enabled
+        "msr cpsr_c, r3\n\t"
+        "stmfd sp!, {r3, lr}\n\t" // r3 is only there to keep the stack 8 byte aligned
+        "mov lr, pc\n\t"
+        "bx %0\n\t"
+        "ldmfd sp!, {r3, lr}\n\t"
+        "mrs r3, cpsr\n\t"
+        "bic r3, r3, #0xdf\n\t"
+        "orr r3, r3, #0x92\n\t" // back to IRQ mode, IRQs disabled
+        "msr cpsr_c, r3\n\t"
+        "ldmfd sp!, {r2, lr}\n\t"
+        "msr spsr_cxsf, r2" ::"r"(handler)
+        : "r0", "r1", "r2", "r3", "r12", "lr", "memory", "cc");
+#endif
+}
+
+IWRAM_CODE ARM_TARGET static void Interrupt_interruptServiceRoutineMain(void)
+{
+    u16 enabled = *Interrupt_enabledInterrupts;
+    u32 irqs = enabled & *Interrupt_acknowledgedInterrupts;
 
     *Interrupt_acknowledgedInterrupts = irqs;
     *Interrupt_acknowledgedInterruptsBios |= irqs;
+
+    for (int i = 0; i < Interrupt_handlerCount; i++)
+    {
+        const struct InterruptHandlerEntry *entry = &Interrupt_handlers[i];
+
+        if (!(irqs & entry->mask))
+        {
+            continue;
+        }
+
+        u16 preempting = Interrupt_nestableMask & enabled & ~entry->mask;
+        if (preempting)
+        {
+            *Interrupt_enabledInterrupts = preempting;
+            Interrupt_callNested(entry->handler);
+            *Interrupt_enabledInterrupts = enabled;
+        }
+        else
+        {
+            entry->handler();
+        }
+    }
 }
 
 void Interrupt_Init(void)
@@ -26,21 +96,107 @@ void Interrupt_Init(void)
     *Interrupt_isrMainRegister = &Interrupt_interruptServiceRoutineMain;
 }
 
-void Interrupt_EnableType(enum InterruptType interruptType)
+static void Interrupt_setTypeSourceEnabled(enum InterruptType interruptType, bool enabled)
 {
     switch (interruptType)
     {
     case InterruptType_VBlank:
-        Graphics_SetVBlankInterrupt(true);
+        Graphics_SetVBlankInterrupt(enabled);
         break;
-    default: // TODO: the rest of these
+    case InterruptType_HBlank:
+        Graphics_SetHBlankInterrupt(enabled);
+        break;
+    case InterruptType_VCount:
+        Graphics_SetVCountInterrupt(enabled);
+        break;
+    case InterruptType_Timer0:
+    case InterruptType_Timer1:
+    case InterruptType_Timer2:
+    case InterruptType_Timer3:
+        Timer_SetInterruptEnabled(interruptType - InterruptType_Timer0, enabled);
+        break;
+    case InterruptType_Keypad:
+        Input_SetInterruptEnabled(enabled);
+        break;
+    default: // DMA interrupts are requested per transfer with DmaSettings.interruptOnFinish, the serial one is requested in
+             // REG_SIOCNT by whoever starts the transfer, and the cartridge one has no switch
         break;
     }
+}
 
+void Interrupt_EnableType(enum InterruptType interruptType)
+{
+    Interrupt_setTypeSourceEnabled(interruptType, true);
     *Interrupt_enabledInterrupts |= (1 << interruptType);
 }
 
+void Interrupt_DisableType(enum InterruptType interruptType)
+{
+    *Interrupt_enabledInterrupts &= ~(1 << interruptType);
+    Interrupt_setTypeSourceEnabled(interruptType, false);
+}
+
 void Interrupt_Enable(void)
 {
     *Interrupt_shouldThereBeInterrupts = 1;
-}
\ No newline at end of file
+}
+
+bool Interrupt_AddHandler(enum InterruptType interruptType, InterruptHandler handler, int priority)
+{
+    if (Interrupt_handlerCount == Interrupt_MaxHandlers)
+    {
+        return false;
+    }
+
+    // The service routine mustn't see the table half updated
+    u16 interruptsWereEnabled = *Interrupt_shouldThereBeInterrupts;
+    *Interrupt_shouldThereBeInterrupts = 0;
+
+    int insertAt = Interrupt_handlerCount;
+    while (insertAt > 0 && Interrupt_handlers[insertAt - 1].priority > priority)
+    {
+        Interrupt_handlers[insertAt] = Interrupt_handlers[insertAt - 1];
+        insertAt--;
+    }
+
+    Interrupt_handlers[insertAt] = (struct InterruptHandlerEntry){
+        .mask = 1 << interruptType,
+        .priority = priority,
+        .handler = handler,
+    };
+    Interrupt_handlerCount++;
+
+    *Interrupt_shouldThereBeInterrupts = interruptsWereEnabled;
+    return true;
+}
+
+void Interrupt_RemoveHandler(enum InterruptType interruptType, InterruptHandler handler)
+{
+    u16 interruptsWereEnabled = *Interrupt_shouldThereBeInterrupts;
+    *Interrupt_shouldThereBeInterrupts = 0;
+
+    u16 mask = 1 << interruptType;
+    int kept = 0;
+    for (int i = 0; i < Interrupt_handlerCount; i++)
+    {
+        if (Interrupt_handlers[i].mask != mask || Interrupt_handlers[i].handler != handler)
+        {
+            Interrupt_handlers[kept++] = Interrupt_handlers[i];
+        }
+    }
+    Interrupt_handlerCount = kept;
+
+    *Interrupt_shouldThereBeInterrupts = interruptsWereEnabled;
+}
+
+void Interrupt_SetNestable(enum InterruptType interruptType, bool nestable)
+{
+    if (nestable)
+    {
+        Interrupt_nestableMask |= 1 << interruptType;
+    }
+    else
+    {
+        Interrupt_nestableMask &= ~(1 << interruptType);
+    }
+}
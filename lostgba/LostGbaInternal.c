@@ -1,7 +1,48 @@
 #include "LostGbaInternal.h"
 
+#include <lostgba/SystemCalls.h>
+
 void LostGBA_SetBits16(u16 *target, u16 value, u16 length, u16 shift)
 {
     u16 mask = LostGBA_AllOnes16(length);
     (*target) = (*target & ~(mask << shift)) | ((value & mask) << shift);
-}
\ No newline at end of file
+}
+// The top 4 bits of the first byte of the compressed data say which compression was used
+enum LostGBA_CompressionType
+{
+    LostGBA_CompressionType_LZ77 = 1,
+    LostGBA_CompressionType_Huffman = 2,
+    LostGBA_CompressionType_RunLength = 3,
+};
+
+void LostGBA_Decompress(const void *source, volatile void *destination, bool toVram)
+{
+    switch (*(const u8 *)source >> 4)
+    {
+    case LostGBA_CompressionType_LZ77:
+        if (toVram)
+        {
+            SystemCall_LZ77UnCompVram(source, destination);
+        }
+        else
+        {
+            SystemCall_LZ77UnCompWram(source, (void *)destination);
+        }
+        break;
+    case LostGBA_CompressionType_Huffman:
+        SystemCall_HuffUnComp(source, destination);
+        break;
+    case LostGBA_CompressionType_RunLength:
+        if (toVram)
+        {
+            SystemCall_RLUnCompVram(source, destination);
+        }
+        else
+        {
+            SystemCall_RLUnCompWram(source, (void *)destination);
+        }
+        break;
+    default: // Not compressed data, so nothing sensible to do
+        break;
+    }
+}
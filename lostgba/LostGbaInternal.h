@@ -12,8 +12,47 @@
         __builtin_unreachable(); \
     } while (0)
 
-#define IWRAM_CODE __attribute__((section(".iwram"), long_call))
-#define ARM_TARGET __attribute__((target("arm")))
+#define IWRAM_CODE LOSTGBA_IWRAM_CODE
+#define ARM_TARGET LOSTGBA_ARM_CODE
+
+#ifdef LOSTGBA_HOST
+
+/**
+ * @brief Where GBA address @p address lives in the simulated memory image of the host build
+ *
+ * A constant expression, so it can be used to initialise statics. Addresses outside the memory image alias
+ * somewhere inside it rather than crashing.
+ */
+#define LOSTGBA_HOST_OFFSET(address)                                                            \
+    ((address) >> 24 == 0x02                        ? 0x00000 + ((address) & 0x3ffff)           \
+     : (address) >> 24 == 0x03                      ? 0x40000 + ((address) & 0x7fff)            \
+     : ((address) & 0xfffff000) == 0x04fff000       ? 0x48400 + ((address) & 0xfff)             \
+     : (address) >> 24 == 0x04                      ? 0x48000 + ((address) & 0x3ff)             \
+     : (address) >> 24 == 0x05                      ? 0x49400 + ((address) & 0x3ff)             \
+     : (address) >> 24 == 0x06                      ? 0x49800 + ((address) & 0x1ffff)           \
+                                                    : 0x69800 + ((address) & 0x3ff))
+
+/** The size of the simulated memory image in bytes */
+#define LOSTGBA_HOST_MEMORY_SIZE 0x69c00
+
+/** The simulated memory image. Defined in host/HostMemory.c */
+extern u8 LostGBA_hostMemory[LOSTGBA_HOST_MEMORY_SIZE];
+
+/** The address of GBA memory address @p address, as a void pointer */
+#define LOSTGBA_ADDRESS(address) ((void *)&LostGBA_hostMemory[LOSTGBA_HOST_OFFSET(address)])
+
+/** What Interrupt_Init() sets as the interrupt service routine. Called by Host_RaiseInterrupt() */
+extern void (*LostGBA_hostInterruptServiceRoutine)(void);
+
+/** Does the transfer for Dma_Start() and friends in software, and accounts for the cycles it would take */
+void LostGBA_HostDmaTransfer(int channel, const volatile void *source, volatile void *destination, u32 count, u16 control);
+
+#else
+
+/** The address of GBA memory address @p address, as a void pointer. Goes via a simulated memory image in the host build */
+#define LOSTGBA_ADDRESS(address) ((void *)(address))
+
+#endif
 
 /**
  * @brief Utility function to set bits at a certain location
@@ -22,6 +61,32 @@
  */
 void LostGBA_SetBits16(u16 *target, u16 value, u16 length, u16 shift);
 
+/**
+ * @brief Decompresses BIOS compatible compressed data (as output by grit)
+ *
+ * Picks the correct BIOS decompression routine based on the header of the compressed data. If @p toVram is true,
+ * only 16 bit writes are used so this is safe to use for VRAM and palette memory.
+ */
+void LostGBA_Decompress(const void *source, volatile void *destination, bool toVram);
+
+/** The number of entries in LostGBA_SineTable, which covers one full turn */
+#define LostGBA_SineTableLength 512
+
+/** sin(2 * pi * i / LostGBA_SineTableLength) in 4.12 fixed point. Lives in ROM */
+extern const s16 LostGBA_SineTable[LostGBA_SineTableLength];
+
+/** The number of entries in LostGBA_ArcTanTable, which covers ratios from 0 to 1 inclusive */
+#define LostGBA_ArcTanTableLength 257
+
+/** atan(i / 256) where 0x10000 is a full turn. Lives in ROM */
+extern const u16 LostGBA_ArcTanTable[LostGBA_ArcTanTableLength];
+
+/** The number of entries in LostGBA_ReciprocalTable */
+#define LostGBA_ReciprocalTableLength 257
+
+/** 1 / i in 0.32 fixed point, rounded to nearest. Entries 0 and 1 are unused. Lives in ROM */
+extern const u32 LostGBA_ReciprocalTable[LostGBA_ReciprocalTableLength];
+
 /**
  * @brief Returns a number with the first n bits set to 1
  */
@@ -1,78 +1,64 @@
 #include <lostgba/ObjectAttribute.h>
+
 #include "LostGbaInternal.h"
 
 struct ObjectAttribute objectAttributeBuffer[ObjectAttributeBuffer_Length];
 struct ObjectAffine *objectAffineBuffer = (struct ObjectAffine *)objectAttributeBuffer;
 
-void ObjectAttribute_SetPos(struct ObjectAttribute *attr, int x, int y)
-{
-    LostGBA_SetBits16(&attr->attr0, y, 8, 0);
-    LostGBA_SetBits16(&attr->attr1, x, 9, 0);
-}
-
-void ObjectAttribute_SetDisplayMode(struct ObjectAttribute *attr, enum ObjectAttributeDisplayMode displayMode)
-{
-    LostGBA_SetBits16(&attr->attr0, displayMode, 2, 8);
-}
-
-void ObjectAttribute_SetGraphicsMode(struct ObjectAttribute *attr, enum ObjectAttributeGraphicsMode graphicsMode)
-{
-    LostGBA_SetBits16(&attr->attr0, graphicsMode, 2, 10);
-}
-
-void ObjectAttribute_SetMosaicEnabled(struct ObjectAttribute *attr, bool enabled)
-{
-    LostGBA_SetBits16(&attr->attr0, enabled, 1, 12);
-}
-
-void ObjectAttribute_SetColourMode(struct ObjectAttribute *attr, enum ObjectAttributeColourMode colourMode)
-{
-    LostGBA_SetBits16(&attr->attr0, colourMode, 2, 13);
-}
-
-void ObjectAttribute_SetShape(struct ObjectAttribute *attr, enum ObjectAttributeShape shape)
-{
-    LostGBA_SetBits16(&attr->attr0, shape, 2, 14);
-}
-
-void ObjectAttribute_SetHFlip(struct ObjectAttribute *attr, bool hflip)
-{
-    LostGBA_SetBits16(&attr->attr1, hflip, 1, 12);
-}
+// Starts off all dirty so that the first copy initialises the whole of the object attribute memory
+u32 objectAttributeBufferDirtyGroups = ~0u;
 
-void ObjectAttribute_SetVFlip(struct ObjectAttribute *attr, bool vflip)
-{
-    LostGBA_SetBits16(&attr->attr1, vflip, 1, 13);
-}
+#define OBJECT_AFFINE_ANGLE_SHIFT 7 // 0x10000 steps in a turn down to LostGBA_SineTableLength
+#define OBJECT_AFFINE_QUARTER_TURN (LostGBA_SineTableLength / 4)
 
-void ObjectAttribute_SetSize(struct ObjectAttribute *attr, enum ObjectAttributeSize size)
+IWRAM_CODE ARM_TARGET static void ObjectAffine_setRotationScale(struct ObjectAffine *affine, u32 angle, s32 scaleX, s32 scaleY)
 {
-    LostGBA_SetBits16(&attr->attr1, size, 2, 14);
+    u32 index = angle >> OBJECT_AFFINE_ANGLE_SHIFT;
+    s32 sin = LostGBA_SineTable[index];
+    s32 cos = LostGBA_SineTable[(index + OBJECT_AFFINE_QUARTER_TURN) & (LostGBA_SineTableLength - 1)];
+
+    // The sine table is 4.12 and the scales are 8.8, so shift by 12 to end up in 8.8
+    affine->pa = (cos * scaleX) >> 12;
+    affine->pb = (-sin * scaleX) >> 12;
+    affine->pc = (sin * scaleY) >> 12;
+    affine->pd = (cos * scaleY) >> 12;
 }
 
-void ObjectAttribute_SetTile(struct ObjectAttribute *attr, u32 tileId)
+void LOSTGBA_UNSAFE(ObjectAffine_SetIdentity)(int affineIndex)
 {
-    LostGBA_SetBits16(&attr->attr2, tileId, 10, 0);
+    struct ObjectAffine *affine = &objectAffineBuffer[affineIndex];
+    affine->pa = 0x100;
+    affine->pb = 0;
+    affine->pc = 0;
+    affine->pd = 0x100;
+    ObjectAffineBuffer_MarkDirty(affineIndex);
 }
 
-void ObjectAttribute_SetPriority(struct ObjectAttribute *attr, u16 priority)
+void LOSTGBA_UNSAFE(ObjectAffine_SetRotationScale)(int affineIndex, u16 angle, s16 scaleX, s16 scaleY)
 {
-    LostGBA_SetBits16(&attr->attr2, priority, 2, 10);
+    ObjectAffine_setRotationScale(&objectAffineBuffer[affineIndex], angle, scaleX, scaleY);
+    ObjectAffineBuffer_MarkDirty(affineIndex);
 }
 
-void ObjectAttribute_SetPaletteBank(struct ObjectAttribute *attr, u16 paletteBank)
+IWRAM_CODE ARM_TARGET void ObjectAffineBuffer_SetRotationScales(int firstAffineIndex, const struct ObjectAffineTransform *transforms, int count)
 {
-    LostGBA_SetBits16(&attr->attr2, paletteBank, 4, 12);
-}
-
-#define OBJECT_ATTRIBUTE_MEMORY_LOCATION ((struct ObjectAttribute *)(void *)0x07000000)
+    if (firstAffineIndex + count > ObjectAffineBuffer_Length)
+    {
+        count = ObjectAffineBuffer_Length - firstAffineIndex;
+    }
 
-void ObjectAttributeBuffer_CopyBufferToMemory(void)
-{
-    struct ObjectAttribute *objectAttributeSystemMemoryLocation = OBJECT_ATTRIBUTE_MEMORY_LOCATION;
+    if (count <= 0)
+    {
+        return;
+    }
 
-    for (int i = 0; i < ObjectAttributeBuffer_Length; i++)
+    struct ObjectAffine *affine = &objectAffineBuffer[firstAffineIndex];
+    for (int i = 0; i < count; i++)
     {
-        objectAttributeSystemMemoryLocation[i] = objectAttributeBuffer[i];
+        ObjectAffine_setRotationScale(&affine[i], transforms[i].angle, transforms[i].scaleX, transforms[i].scaleY);
     }
-}
\ No newline at end of file
+
+    // count is at most 32 here, and 1u << 32 is undefined
+    u32 dirty = count == ObjectAffineBuffer_Length ? ~0u : ((1u << count) - 1);
+    objectAttributeBufferDirtyGroups |= dirty << firstAffineIndex;
+}
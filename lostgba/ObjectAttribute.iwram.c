@@ -0,0 +1,38 @@
+// The object attribute upload runs every vblank, so it is compiled as ARM code and runs from IWRAM (see the
+// *.iwram.c rule in the Makefile).
+
+#include <lostgba/ObjectAttribute.h>
+#include <lostgba/Dma.h>
+
+#include "LostGbaInternal.h"
+
+#define OBJECT_ATTRIBUTE_GROUP_LENGTH (ObjectAttributeBuffer_Length / ObjectAffineBuffer_Length)
+
+#define OBJECT_ATTRIBUTE_MEMORY_LOCATION ((struct ObjectAttribute *)LOSTGBA_ADDRESS(0x07000000))
+
+#define OBJECT_ATTRIBUTE_GROUP_WORDS (OBJECT_ATTRIBUTE_GROUP_LENGTH * sizeof(struct ObjectAttribute) / sizeof(u32))
+
+void ObjectAttributeBuffer_CopyBufferToMemory(void)
+{
+    u32 dirtyGroups = objectAttributeBufferDirtyGroups;
+    objectAttributeBufferDirtyGroups = 0;
+
+    // Upload each run of consecutive dirty groups with a single DMA
+    while (dirtyGroups)
+    {
+        int firstGroup = __builtin_ctz(dirtyGroups);
+        u32 remaining = ~(dirtyGroups >> firstGroup);
+        int groupCount = remaining ? __builtin_ctz(remaining) : ObjectAffineBuffer_Length - firstGroup;
+
+        Dma_Copy32(&objectAttributeBuffer[firstGroup * OBJECT_ATTRIBUTE_GROUP_LENGTH],
+                   &OBJECT_ATTRIBUTE_MEMORY_LOCATION[firstGroup * OBJECT_ATTRIBUTE_GROUP_LENGTH],
+                   groupCount * OBJECT_ATTRIBUTE_GROUP_WORDS);
+
+        if (firstGroup + groupCount == ObjectAffineBuffer_Length)
+        {
+            break;
+        }
+
+        dirtyGroups &= ~0u << (firstGroup + groupCount);
+    }
+}
@@ -0,0 +1,95 @@
+#include <lostgba/Palette.h>
+
+#include "PaletteInternal.h"
+#include "LostGbaInternal.h"
+
+u16 paletteBuffer[Palette_Length] LOSTGBA_ALIGN(4);
+u32 paletteBufferDirtyBanks = 0;
+
+// Only read when an effect changes, so it can live in the slower EWRAM and leave IWRAM for paletteBuffer
+LOSTGBA_EWRAM_BSS u16 paletteBase[Palette_Length] LOSTGBA_ALIGN(4);
+
+// The mask of every bank with a colour in [first, first + count) of the combined palette
+static u32 Palette_banksCovering(int first, int count)
+{
+    if (count <= 0)
+    {
+        return 0;
+    }
+
+    int firstBank = first / Palette_BankLength;
+    int lastBank = (first + count - 1) / Palette_BankLength;
+
+    u32 upToLast = lastBank >= 31 ? ~0u : (1u << (lastBank + 1)) - 1;
+    return upToLast & (~0u << firstBank);
+}
+
+void Palette_Load(enum PaletteType type, int firstColour, const u16 *colours, int count)
+{
+    int first = type * TileMap_PaletteLength + firstColour;
+
+    for (int i = 0; i < count; i++)
+    {
+        paletteBase[first + i] = colours[i];
+    }
+
+    Palette_Restore(Palette_banksCovering(first, count));
+}
+
+void Palette_LoadCompressed(enum PaletteType type, const void *compressedColours)
+{
+    int first = type * TileMap_PaletteLength;
+
+    // The decompressed size in bytes is in the top 24 bits of the header
+    int count = (*(const u32 *)compressedColours >> 8) / sizeof(u16);
+
+    LostGBA_Decompress(compressedColours, &paletteBase[first], false);
+    Palette_Restore(Palette_banksCovering(first, count));
+}
+
+void Palette_SetColour(enum PaletteType type, int index, u16 colour)
+{
+    int combinedIndex = type * TileMap_PaletteLength + index;
+
+    paletteBase[combinedIndex] = colour;
+    paletteBuffer[combinedIndex] = colour;
+    PaletteBuffer_MarkDirty(Palette_banksCovering(combinedIndex, 1));
+}
+
+u16 Palette_GetColour(enum PaletteType type, int index)
+{
+    return paletteBase[type * TileMap_PaletteLength + index];
+}
+
+void Palette_Restore(u32 banks)
+{
+    PaletteKernel_Blend(banks, (const u32 *)paletteBase, 1, 0);
+    PaletteBuffer_MarkDirty(banks);
+}
+
+static int Palette_clampAmount(int amount)
+{
+    return amount < 0 ? 0 : amount > Palette_MaxAmount ? Palette_MaxAmount : amount;
+}
+
+void Palette_Fade(u32 banks, u16 colour, int amount)
+{
+    amount = Palette_clampAmount(amount);
+    u32 colourPair = colour | ((u32)colour << 16);
+
+    PaletteKernel_Blend(banks, &colourPair, 0, amount);
+    PaletteBuffer_MarkDirty(banks);
+}
+
+void Palette_Blend(u32 banks, const u16 *target, int amount)
+{
+    amount = Palette_clampAmount(amount);
+    PaletteKernel_Blend(banks, (const u32 *)target, 1, amount);
+    PaletteBuffer_MarkDirty(banks);
+}
+
+void Palette_Tint(u32 banks, u16 colour)
+{
+    PaletteKernel_Tint(banks, colour);
+    PaletteBuffer_MarkDirty(banks);
+}
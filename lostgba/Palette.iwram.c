@@ -0,0 +1,115 @@
+// The palette effects and upload. Fades run every frame of a transition over up to the whole palette, so these
+// are compiled as ARM code and run from IWRAM (see the *.iwram.c rule in the Makefile).
+//
+// The effects work on two BGR555 colours packed into a word. Multiplying a packed word by an amount only works if
+// every product has room to grow without running into the next component, so the 6 components are split into
+// two groups with at least 10 bits between components, and each group is done with a single multiply.
+
+#include <lostgba/Dma.h>
+
+#include "PaletteInternal.h"
+#include "LostGbaInternal.h"
+
+#define PALETTE_MEMORY_LOCATION ((u16 *)LOSTGBA_ADDRESS(0x05000000))
+
+#define PALETTE_BANK_WORDS (Palette_BankLength * sizeof(u16) / sizeof(u32))
+#define PALETTE_BANK_COUNT (Palette_Length / Palette_BankLength)
+
+// Red and blue of the first colour and green of the second, at bits 0, 10 and 21
+#define PALETTE_GROUP_LOW 0x03e07c1fu
+// Green of the first colour and red and blue of the second, once shifted down by 5 to bits 0, 11 and 21
+#define PALETTE_GROUP_HIGH 0x03e0f81fu
+
+// Each component is at most 31 and the weights add up to Palette_MaxAmount, so the weighted sum of a component is
+// at most 992 and fits in the 10 bits it has
+static u32 PaletteKernel_blendPair(u32 colours, u32 targetLowWeighted, u32 targetHighWeighted, u32 weight)
+{
+    u32 low = (((colours & PALETTE_GROUP_LOW) * weight + targetLowWeighted) >> 5) & PALETTE_GROUP_LOW;
+    u32 high = ((((colours >> 5) & PALETTE_GROUP_HIGH) * weight + targetHighWeighted) >> 5) & PALETTE_GROUP_HIGH;
+
+    return low | (high << 5);
+}
+
+void PaletteKernel_Blend(u32 banks, const u32 *target, int targetStep, int amount)
+{
+    u32 weight = Palette_MaxAmount - amount;
+
+    while (banks)
+    {
+        int bank = __builtin_ctz(banks);
+        banks &= banks - 1;
+
+        int firstWord = bank * PALETTE_BANK_WORDS;
+        const u32 *base = (const u32 *)paletteBase + firstWord;
+        u32 *buffer = (u32 *)paletteBuffer + firstWord;
+        const u32 *bankTarget = target + firstWord * targetStep;
+
+        for (u32 i = 0; i < PALETTE_BANK_WORDS; i++)
+        {
+            u32 targetColours = *bankTarget;
+            bankTarget += targetStep;
+
+            buffer[i] = PaletteKernel_blendPair(base[i],
+                                                (targetColours & PALETTE_GROUP_LOW) * amount,
+                                                ((targetColours >> 5) & PALETTE_GROUP_HIGH) * amount,
+                                                weight);
+        }
+    }
+}
+
+// Each component times (tint component + 1) is at most 31 * 32, which fits in the 16 bits between the same
+// component of the two colours
+#define PALETTE_COMPONENT_PAIR 0x001f001fu
+
+void PaletteKernel_Tint(u32 banks, u16 colour)
+{
+    u32 redScale = (colour & 31) + 1;
+    u32 greenScale = ((colour >> 5) & 31) + 1;
+    u32 blueScale = ((colour >> 10) & 31) + 1;
+
+    while (banks)
+    {
+        int bank = __builtin_ctz(banks);
+        banks &= banks - 1;
+
+        int firstWord = bank * PALETTE_BANK_WORDS;
+        const u32 *base = (const u32 *)paletteBase + firstWord;
+        u32 *buffer = (u32 *)paletteBuffer + firstWord;
+
+        for (u32 i = 0; i < PALETTE_BANK_WORDS; i++)
+        {
+            u32 colours = base[i];
+
+            u32 red = ((colours & PALETTE_COMPONENT_PAIR) * redScale >> 5) & PALETTE_COMPONENT_PAIR;
+            u32 green = (((colours >> 5) & PALETTE_COMPONENT_PAIR) * greenScale >> 5) & PALETTE_COMPONENT_PAIR;
+            u32 blue = (((colours >> 10) & PALETTE_COMPONENT_PAIR) * blueScale >> 5) & PALETTE_COMPONENT_PAIR;
+
+            buffer[i] = red | (green << 5) | (blue << 10);
+        }
+    }
+}
+
+void PaletteBuffer_CopyBufferToMemory(void)
+{
+    u32 dirtyBanks = paletteBufferDirtyBanks;
+    paletteBufferDirtyBanks = 0;
+
+    // Upload each run of consecutive dirty banks with a single DMA
+    while (dirtyBanks)
+    {
+        int firstBank = __builtin_ctz(dirtyBanks);
+        u32 remaining = ~(dirtyBanks >> firstBank);
+        int bankCount = remaining ? __builtin_ctz(remaining) : PALETTE_BANK_COUNT - firstBank;
+
+        Dma_Copy32(&paletteBuffer[firstBank * Palette_BankLength],
+                   &PALETTE_MEMORY_LOCATION[firstBank * Palette_BankLength],
+                   bankCount * PALETTE_BANK_WORDS);
+
+        if (firstBank + bankCount == PALETTE_BANK_COUNT)
+        {
+            break;
+        }
+
+        dirtyBanks &= ~0u << (firstBank + bankCount);
+    }
+}
@@ -0,0 +1,22 @@
+/**
+ * @file PaletteInternal.h
+ */
+
+#pragma once
+
+#include <lostgba/Palette.h>
+
+/** The colours as loaded, laid out like paletteBuffer. Effects read from here and write to paletteBuffer */
+extern u16 paletteBase[Palette_Length];
+
+// The effect loops for Palette.h, in Palette.iwram.c. Each one rewrites the banks of paletteBuffer in banks from
+// paletteBase, but doesn't mark them dirty.
+
+/**
+ * Blends towards target by amount / Palette_MaxAmount. target is 2 colours packed into a word. It moves on by
+ * targetStep words for each word of the palette, so a step of 0 blends every colour towards the same pair.
+ */
+void PaletteKernel_Blend(u32 banks, const u32 *target, int targetStep, int amount);
+
+/** Multiplies each component by the matching one of colour */
+void PaletteKernel_Tint(u32 banks, u16 colour);
@@ -0,0 +1,100 @@
+#include <lostgba/Profile.h>
+#include <lostgba/Timer.h>
+#include <lostgba/DebugLog.h>
+
+struct ProfileZone profileZones[Profile_MaxZones];
+
+// The number of cycles spent inside Profile_Cycles itself, which ends up in every measurement
+static u32 Profile_overheadCycles = 0;
+
+u32 Profile_Cycles(void)
+{
+    u16 high;
+    u16 low;
+
+    // If the low timer overflows between the two reads then the high one will have changed, so try again
+    do
+    {
+        high = Timer_GetCount(TimerNumber_3);
+        low = Timer_GetCount(TimerNumber_2);
+    } while (high != Timer_GetCount(TimerNumber_3));
+
+    return ((u32)high << 16) | low;
+}
+
+void Profile_Reset(void)
+{
+    for (int i = 0; i < Profile_MaxZones; i++)
+    {
+        struct ProfileZone *zone = &profileZones[i];
+
+        zone->count = 0;
+        zone->minCycles = ~0u;
+        zone->maxCycles = 0;
+        zone->totalCycles = 0;
+    }
+}
+
+void Profile_Init(void)
+{
+    Timer_Start(TimerNumber_3, 0, (struct TimerSettings){.cascade = true});
+    Timer_Start(TimerNumber_2, 0, (struct TimerSettings){.prescaler = TimerPrescaler_1});
+
+    Profile_Reset();
+
+    u32 start = Profile_Cycles();
+    u32 end = Profile_Cycles();
+    Profile_overheadCycles = end - start;
+}
+
+void LOSTGBA_UNSAFE(Profile_SetZoneName)(int zone, const char *name)
+{
+    profileZones[zone].name = name;
+}
+
+void LOSTGBA_UNSAFE(Profile_Begin)(int zone)
+{
+    profileZones[zone].startCycles = Profile_Cycles();
+}
+
+void LOSTGBA_UNSAFE(Profile_End)(int zone)
+{
+    u32 end = Profile_Cycles();
+    struct ProfileZone *profileZone = &profileZones[zone];
+
+    u32 cycles = end - profileZone->startCycles;
+    cycles = cycles > Profile_overheadCycles ? cycles - Profile_overheadCycles : 0;
+
+    profileZone->count++;
+    profileZone->totalCycles += cycles;
+
+    if (cycles < profileZone->minCycles)
+    {
+        profileZone->minCycles = cycles;
+    }
+
+    if (cycles > profileZone->maxCycles)
+    {
+        profileZone->maxCycles = cycles;
+    }
+}
+
+void Profile_Report(void)
+{
+    for (int i = 0; i < Profile_MaxZones; i++)
+    {
+        const struct ProfileZone *zone = &profileZones[i];
+
+        if (zone->count == 0)
+        {
+            continue;
+        }
+
+        DebugLog_Printf(DebugLogLevel_Info, "PROFILE name=%s count=%lu min=%lu max=%lu avg=%lu",
+                        zone->name ? zone->name : "unnamed",
+                        (unsigned long)zone->count,
+                        (unsigned long)zone->minCycles,
+                        (unsigned long)zone->maxCycles,
+                        (unsigned long)(zone->totalCycles / zone->count));
+    }
+}
@@ -0,0 +1,207 @@
+#include <lostgba/Sound.h>
+#include <lostgba/Dma.h>
+#include <lostgba/Interrupt.h>
+#include <lostgba/Timer.h>
+
+#include <stddef.h>
+
+#include "SoundInternal.h"
+#include "LostGbaInternal.h"
+
+struct SoundChannel soundChannels[Sound_ChannelCount];
+
+s8 soundBuffers[2][2][Sound_SamplesPerFrame] LOSTGBA_ALIGN(4);
+volatile int soundFrontBuffer = 0;
+volatile bool soundMixReady = false;
+
+static vu16 *Sound_controlHighRegister = (vu16 *)LOSTGBA_ADDRESS(0x04000082);
+static vu16 *Sound_masterControlRegister = (vu16 *)LOSTGBA_ADDRESS(0x04000084);
+static vu32 *Sound_fifoA = (vu32 *)LOSTGBA_ADDRESS(0x040000A0);
+static vu32 *Sound_fifoB = (vu32 *)LOSTGBA_ADDRESS(0x040000A4);
+
+#define SOUND_MASTER_ENABLE (1 << 7)
+
+// Both DirectSound channels at full volume, A to the left speaker, B to the right, both clocked by timer 0 and
+// with their FIFOs reset
+#define SOUND_DIRECT_SOUND_CONTROL ((1 << 2) | (1 << 3) | (1 << 9) | (1 << 11) | (1 << 12) | (1 << 15))
+
+#define SOUND_CYCLES_PER_SAMPLE 924
+
+// A handle is the channel index in the bottom bits, and a count of every sound ever played above that. The count
+// starts at 1, so no handle is ever Sound_InvalidHandle.
+#define SOUND_HANDLE_CHANNEL_BITS 3
+#define SOUND_HANDLE_CHANNEL(handle) ((handle) & LostGBA_AllOnes16(SOUND_HANDLE_CHANNEL_BITS))
+#define SOUND_HANDLE_SERIAL(handle) ((handle) >> SOUND_HANDLE_CHANNEL_BITS)
+
+_Static_assert(Sound_ChannelCount <= (1 << SOUND_HANDLE_CHANNEL_BITS), "Sound handles need more channel bits");
+
+static u32 Sound_nextSerial = 1;
+
+// Restarts the FIFO refills from the start of the front buffer. Has to happen every VBlank, since that is
+// exactly when the DMA runs off the end of it.
+static void Sound_startDma(void)
+{
+    const struct DmaSettings fifoSettings = {
+        .destinationControl = DmaAddressControl_Fixed,
+        .sourceControl = DmaAddressControl_Increment,
+        .chunkSize = DmaChunkSize_32,
+        .timing = DmaTiming_Special,
+        .repeat = true,
+    };
+
+    // The count is ignored for FIFO transfers, which always move 4 words at a time
+    Dma_Start(DmaChannel_1, soundBuffers[soundFrontBuffer][0], Sound_fifoA, 4, fifoSettings);
+    Dma_Start(DmaChannel_2, soundBuffers[soundFrontBuffer][1], Sound_fifoB, 4, fifoSettings);
+}
+
+static void Sound_vblank(void)
+{
+    // If the next frame isn't mixed yet, play the current one again rather than something older
+    if (soundMixReady)
+    {
+        soundFrontBuffer = !soundFrontBuffer;
+        soundMixReady = false;
+    }
+
+    Sound_startDma();
+}
+
+void Sound_Init(void)
+{
+    Sound_StopAll();
+
+    for (int i = 0; i < 2; i++)
+    {
+        for (int j = 0; j < 2; j++)
+        {
+            for (int k = 0; k < Sound_SamplesPerFrame; k++)
+            {
+                soundBuffers[i][j][k] = 0;
+            }
+        }
+    }
+
+    soundFrontBuffer = 0;
+    soundMixReady = false;
+
+    // The sound registers can't be written until the master enable is set
+    *Sound_masterControlRegister = SOUND_MASTER_ENABLE;
+    *Sound_controlHighRegister = SOUND_DIRECT_SOUND_CONTROL;
+
+    Timer_Start(TimerNumber_0, 0x10000 - SOUND_CYCLES_PER_SAMPLE, (struct TimerSettings){.prescaler = TimerPrescaler_1});
+    Sound_startDma();
+
+    // Before any other VBlank handler, so the swap happens as close to the start of the frame as possible
+    Interrupt_AddHandler(InterruptType_VBlank, Sound_vblank, -1);
+}
+
+static struct SoundChannel *Sound_channelFor(SoundHandle handle)
+{
+    struct SoundChannel *channel = &soundChannels[SOUND_HANDLE_CHANNEL(handle)];
+    return channel->data && channel->handle == handle ? channel : NULL;
+}
+
+static void Sound_updateVolumes(struct SoundChannel *channel)
+{
+    int leftScale = channel->pan > 0 ? Sound_MaxPan - channel->pan : Sound_MaxPan;
+    int rightScale = channel->pan < 0 ? Sound_MaxPan + channel->pan : Sound_MaxPan;
+
+    channel->leftVolume = channel->volume * leftScale / Sound_MaxPan;
+    channel->rightVolume = channel->volume * rightScale / Sound_MaxPan;
+}
+
+static int Sound_clamp(int value, int min, int max)
+{
+    return value < min ? min : value > max ? max : value;
+}
+
+SoundHandle Sound_Play(const struct SoundSample *sample, int volume, int pan)
+{
+    // Use a free channel if there is one, otherwise replace whatever has been playing the longest
+    int channelIndex = 0;
+    for (int i = 0; i < Sound_ChannelCount; i++)
+    {
+        if (!soundChannels[i].data)
+        {
+            channelIndex = i;
+            break;
+        }
+
+        if (SOUND_HANDLE_SERIAL(soundChannels[i].handle) < SOUND_HANDLE_SERIAL(soundChannels[channelIndex].handle))
+        {
+            channelIndex = i;
+        }
+    }
+
+    struct SoundChannel *channel = &soundChannels[channelIndex];
+
+    channel->position = 0;
+    channel->step = (sample->rate << SOUND_POSITION_SHIFT) / Sound_MixRate;
+    channel->end = sample->length << SOUND_POSITION_SHIFT;
+    channel->loopLength = sample->loopStart < sample->length ? (sample->length - sample->loopStart) << SOUND_POSITION_SHIFT : 0;
+    channel->rate = sample->rate;
+    channel->handle = (Sound_nextSerial++ << SOUND_HANDLE_CHANNEL_BITS) | channelIndex;
+    channel->volume = Sound_clamp(volume, 0, Sound_MaxVolume);
+    channel->pan = Sound_clamp(pan, Sound_MinPan, Sound_MaxPan);
+    Sound_updateVolumes(channel);
+
+    // Set last, since this is what makes the mixer pick the channel up
+    channel->data = sample->length ? sample->data : NULL;
+
+    return channel->handle;
+}
+
+void Sound_Stop(SoundHandle handle)
+{
+    struct SoundChannel *channel = Sound_channelFor(handle);
+    if (channel)
+    {
+        channel->data = NULL;
+    }
+}
+
+bool Sound_IsPlaying(SoundHandle handle)
+{
+    return Sound_channelFor(handle) != NULL;
+}
+
+void Sound_SetVolume(SoundHandle handle, int volume)
+{
+    struct SoundChannel *channel = Sound_channelFor(handle);
+    if (channel)
+    {
+        channel->volume = Sound_clamp(volume, 0, Sound_MaxVolume);
+        Sound_updateVolumes(channel);
+    }
+}
+
+void Sound_SetPan(SoundHandle handle, int pan)
+{
+    struct SoundChannel *channel = Sound_channelFor(handle);
+    if (channel)
+    {
+        channel->pan = Sound_clamp(pan, Sound_MinPan, Sound_MaxPan);
+        Sound_updateVolumes(channel);
+    }
+}
+
+void Sound_SetPitch(SoundHandle handle, Fixed16 pitch)
+{
+    struct SoundChannel *channel = Sound_channelFor(handle);
+    if (channel)
+    {
+        // rate * pitch has 16 fractional bits, and the step needs SOUND_POSITION_SHIFT
+        u32 step = pitch > 0 ? ((u64)channel->rate * (u32)pitch / Sound_MixRate) >> (16 - SOUND_POSITION_SHIFT) : 0;
+
+        // A step of 0 would never reach the end
+        channel->step = step ? step : 1;
+    }
+}
+
+void Sound_StopAll(void)
+{
+    for (int i = 0; i < Sound_ChannelCount; i++)
+    {
+        soundChannels[i].data = NULL;
+    }
+}
@@ -0,0 +1,110 @@
+// The sound mixer. Runs every frame, so it is compiled as ARM code and runs from IWRAM (see the *.iwram.c rule in
+// the Makefile).
+
+#include <stddef.h>
+
+#include "SoundInternal.h"
+#include "LostGbaInternal.h"
+
+// Every channel at full volume is 64 times louder than a single sample, so this brings one full volume channel
+// back to its original level. Anything louder than that is clipped.
+#define SOUND_MIX_SHIFT 6
+
+static s32 Sound_leftAccumulator[Sound_SamplesPerFrame];
+static s32 Sound_rightAccumulator[Sound_SamplesPerFrame];
+
+static void Sound_mixChannel(struct SoundChannel *channel)
+{
+    const s8 *data = channel->data;
+    u32 position = channel->position;
+    u32 step = channel->step;
+    u32 end = channel->end;
+    s32 leftVolume = channel->leftVolume;
+    s32 rightVolume = channel->rightVolume;
+
+    s32 *left = Sound_leftAccumulator;
+    s32 *right = Sound_rightAccumulator;
+    u32 remaining = Sound_SamplesPerFrame;
+
+    while (remaining > 0)
+    {
+        // Mix in runs which stop just before the end, so the inner loop doesn't need to check for it
+        u32 untilEnd = (end - position + step - 1) / step;
+        u32 count = untilEnd < remaining ? untilEnd : remaining;
+
+        if (leftVolume | rightVolume)
+        {
+            for (u32 i = 0; i < count; i++)
+            {
+                s32 sample = data[position >> SOUND_POSITION_SHIFT];
+                left[i] += sample * leftVolume;
+                right[i] += sample * rightVolume;
+                position += step;
+            }
+        }
+        else
+        {
+            position += count * step;
+        }
+
+        left += count;
+        right += count;
+        remaining -= count;
+
+        if (position >= end)
+        {
+            if (!channel->loopLength)
+            {
+                channel->data = NULL;
+                return;
+            }
+
+            do
+            {
+                position -= channel->loopLength;
+            } while (position >= end);
+        }
+    }
+
+    channel->position = position;
+}
+
+static s8 Sound_clip(s32 value)
+{
+    value >>= SOUND_MIX_SHIFT;
+    return value > 127 ? 127 : value < -128 ? -128 : value;
+}
+
+void Sound_Mix(void)
+{
+    // The back buffer hasn't been played yet, so there is nowhere to mix into
+    if (soundMixReady)
+    {
+        return;
+    }
+
+    for (int i = 0; i < Sound_SamplesPerFrame; i++)
+    {
+        Sound_leftAccumulator[i] = 0;
+        Sound_rightAccumulator[i] = 0;
+    }
+
+    for (int i = 0; i < Sound_ChannelCount; i++)
+    {
+        if (soundChannels[i].data)
+        {
+            Sound_mixChannel(&soundChannels[i]);
+        }
+    }
+
+    s8 *left = soundBuffers[!soundFrontBuffer][0];
+    s8 *right = soundBuffers[!soundFrontBuffer][1];
+
+    for (int i = 0; i < Sound_SamplesPerFrame; i++)
+    {
+        left[i] = Sound_clip(Sound_leftAccumulator[i]);
+        right[i] = Sound_clip(Sound_rightAccumulator[i]);
+    }
+
+    soundMixReady = true;
+}
@@ -0,0 +1,43 @@
+/**
+ * @file SoundInternal.h
+ */
+
+#pragma once
+
+#include <lostgba/Sound.h>
+
+/** The number of fractional bits in SoundChannel positions and steps */
+#define SOUND_POSITION_SHIFT 12
+
+/** The state of one mixer channel. Shared between Sound.c and the mixer in Sound.iwram.c */
+struct SoundChannel
+{
+    /** The sample data, or NULL if the channel isn't playing */
+    const s8 *data;
+    /** Index of the next sample to mix, in 20.12 fixed point */
+    u32 position;
+    /** How far position moves for each mixed sample, in 20.12 fixed point */
+    u32 step;
+    /** The sample length in 20.12 fixed point. Position is never allowed to reach this */
+    u32 end;
+    /** How far to go back when reaching the end in 20.12 fixed point, or 0 to stop instead */
+    u32 loopLength;
+    /** The handle returned by Sound_Play() for whatever is playing on this channel */
+    SoundHandle handle;
+    /** The sample's own rate, needed to work out step when the pitch changes */
+    u32 rate;
+    u8 volume;
+    s8 pan;
+    /** volume with pan applied. These are what the mixer uses */
+    u8 leftVolume;
+    u8 rightVolume;
+};
+
+extern struct SoundChannel soundChannels[Sound_ChannelCount];
+
+/** [buffer][0 for left, 1 for right]. The DMA plays soundBuffers[soundFrontBuffer] */
+extern s8 soundBuffers[2][2][Sound_SamplesPerFrame];
+extern volatile int soundFrontBuffer;
+
+/** Set by Sound_Mix() once the back buffer is ready, and cleared by the VBlank handler when it swaps */
+extern volatile bool soundMixReady;
@@ -0,0 +1,169 @@
+#include <lostgba/Sprite.h>
+
+#include "LostGbaInternal.h"
+
+#define SPRITE_DEPTH_BUCKETS 256
+#define SPRITE_PRIORITY_BUCKETS 4
+
+// attr0 of a hidden sprite, see ObjectAttributeDisplayMode_Hidden
+#define SPRITE_HIDDEN_ATTR0 (ObjectAttributeDisplayMode_Hidden << 8)
+
+static struct ObjectAttribute Sprite_attributes[Sprite_MaxSprites];
+static u8 Sprite_depths[Sprite_MaxSprites];
+
+// Free handles form a singly linked list through Sprite_nextFree
+static u8 Sprite_nextFree[Sprite_MaxSprites];
+static int Sprite_firstFree;
+
+// The allocated handles, packed at the start. Sprite_liveIndex maps each allocated handle back to its position
+static u8 Sprite_live[Sprite_MaxSprites];
+static u8 Sprite_liveIndex[Sprite_MaxSprites];
+static int Sprite_liveCount;
+
+// How many slots of objectAttributeBuffer the previous Sprite_Commit() filled
+static int Sprite_committedCount;
+
+void Sprite_Init(void)
+{
+    for (int i = 0; i < Sprite_MaxSprites; i++)
+    {
+        Sprite_nextFree[i] = i + 1;
+    }
+
+    Sprite_firstFree = 0;
+    Sprite_liveCount = 0;
+
+    for (int i = 0; i < ObjectAttributeBuffer_Length; i++)
+    {
+        objectAttributeBuffer[i].attr0 = SPRITE_HIDDEN_ATTR0;
+    }
+
+    Sprite_committedCount = 0;
+    ObjectAttributeBuffer_MarkAllDirty();
+}
+
+SpriteHandle Sprite_Alloc(void)
+{
+    if (Sprite_firstFree == Sprite_MaxSprites)
+    {
+        return Sprite_InvalidHandle;
+    }
+
+    SpriteHandle handle = Sprite_firstFree;
+    Sprite_firstFree = Sprite_nextFree[handle];
+
+    Sprite_liveIndex[handle] = Sprite_liveCount;
+    Sprite_live[Sprite_liveCount++] = handle;
+
+    struct ObjectAttribute *attr = &Sprite_attributes[handle];
+    attr->attr0 = 0;
+    attr->attr1 = 0;
+    attr->attr2 = 0;
+    Sprite_depths[handle] = 0;
+
+    return handle;
+}
+
+void Sprite_Free(SpriteHandle handle)
+{
+    // Move the last live handle into the gap so Sprite_live stays packed
+    int index = Sprite_liveIndex[handle];
+    int last = Sprite_live[--Sprite_liveCount];
+    Sprite_live[index] = last;
+    Sprite_liveIndex[last] = index;
+
+    Sprite_nextFree[handle] = Sprite_firstFree;
+    Sprite_firstFree = handle;
+}
+
+struct ObjectAttribute *Sprite_GetAttribute(SpriteHandle handle)
+{
+    return &Sprite_attributes[handle];
+}
+
+void Sprite_SetDepth(SpriteHandle handle, u8 depth)
+{
+    Sprite_depths[handle] = depth;
+}
+
+static inline int Sprite_priority(int handle)
+{
+    return (Sprite_attributes[handle].attr2 >> 10) & (SPRITE_PRIORITY_BUCKETS - 1);
+}
+
+IWRAM_CODE ARM_TARGET void Sprite_Commit(void)
+{
+    int count = Sprite_liveCount;
+    u8 byDepth[Sprite_MaxSprites];
+    u8 sorted[Sprite_MaxSprites];
+
+    // Least significant key first: a counting sort on depth, then a stable one on priority
+    u8 depthStarts[SPRITE_DEPTH_BUCKETS] = {0};
+    for (int i = 0; i < count; i++)
+    {
+        depthStarts[Sprite_depths[Sprite_live[i]]]++;
+    }
+
+    int total = 0;
+    for (int i = 0; i < SPRITE_DEPTH_BUCKETS; i++)
+    {
+        int bucketCount = depthStarts[i];
+        depthStarts[i] = total;
+        total += bucketCount;
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        int handle = Sprite_live[i];
+        byDepth[depthStarts[Sprite_depths[handle]]++] = handle;
+    }
+
+    int priorityStarts[SPRITE_PRIORITY_BUCKETS] = {0};
+    for (int i = 0; i < count; i++)
+    {
+        priorityStarts[Sprite_priority(byDepth[i])]++;
+    }
+
+    total = 0;
+    for (int i = 0; i < SPRITE_PRIORITY_BUCKETS; i++)
+    {
+        int bucketCount = priorityStarts[i];
+        priorityStarts[i] = total;
+        total += bucketCount;
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        int handle = byDepth[i];
+        sorted[priorityStarts[Sprite_priority(handle)]++] = handle;
+    }
+
+    // Only write (and so only mark dirty) slots which have actually changed. The fill field belongs to the
+    // interlaced affine matrices, so only the three attributes are compared and copied
+    u32 dirtyGroups = 0;
+    for (int i = 0; i < count; i++)
+    {
+        const struct ObjectAttribute *source = &Sprite_attributes[sorted[i]];
+        struct ObjectAttribute *destination = &objectAttributeBuffer[i];
+
+        if (destination->attr0 != source->attr0 || destination->attr1 != source->attr1 || destination->attr2 != source->attr2)
+        {
+            destination->attr0 = source->attr0;
+            destination->attr1 = source->attr1;
+            destination->attr2 = source->attr2;
+            dirtyGroups |= 1u << (i / 4);
+        }
+    }
+
+    for (int i = count; i < Sprite_committedCount; i++)
+    {
+        if (objectAttributeBuffer[i].attr0 != SPRITE_HIDDEN_ATTR0)
+        {
+            objectAttributeBuffer[i].attr0 = SPRITE_HIDDEN_ATTR0;
+            dirtyGroups |= 1u << (i / 4);
+        }
+    }
+
+    Sprite_committedCount = count;
+    objectAttributeBufferDirtyGroups |= dirtyGroups;
+}
@@ -0,0 +1,137 @@
+#include <lostgba/SpriteMultiplexer.h>
+#include <lostgba/Interrupt.h>
+
+#include "SpriteMultiplexerInternal.h"
+#include "LostGbaInternal.h"
+
+// attr0 of a hidden sprite, see ObjectAttributeDisplayMode_Hidden
+#define SPRITE_MULTIPLEXER_HIDDEN_ATTR0 (ObjectAttributeDisplayMode_Hidden << 8)
+
+// Everything indexed by virtual sprite is too big for IWRAM, and is only touched by SpriteMultiplexer_Commit() and
+// the once a frame copy of the schedule into IWRAM
+LOSTGBA_EWRAM_BSS struct ObjectAttribute spriteMultiplexerAttributes[SpriteMultiplexer_MaxSprites];
+LOSTGBA_EWRAM_BSS u16 spriteMultiplexerLive[SpriteMultiplexer_MaxSprites];
+int spriteMultiplexerLiveCount = 0;
+
+LOSTGBA_EWRAM_BSS static u16 SpriteMultiplexer_liveIndex[SpriteMultiplexer_MaxSprites];
+
+// Free handles form a singly linked list through SpriteMultiplexer_nextFree
+LOSTGBA_EWRAM_BSS static u16 SpriteMultiplexer_nextFree[SpriteMultiplexer_MaxSprites];
+static int SpriteMultiplexer_firstFree;
+
+int spriteMultiplexerFirstSlot = ObjectAttributeBuffer_Length;
+
+LOSTGBA_EWRAM_BSS struct SpriteMultiplexerSchedule spriteMultiplexerNextSchedule;
+volatile bool spriteMultiplexerScheduleReady = false;
+volatile int spriteMultiplexerNextBand = 0;
+
+struct SpriteMultiplexerStats spriteMultiplexerStats;
+LOSTGBA_EWRAM_BSS u32 spriteMultiplexerLineCycles[Graphics_ScreenHeight];
+
+// The dirty groups of objectAttributeBuffer covering the multiplexer's slots
+static u32 SpriteMultiplexer_dirtyGroups = 0;
+
+static void SpriteMultiplexer_vblank(void)
+{
+    if (spriteMultiplexerScheduleReady)
+    {
+        SpriteMultiplexerKernel_CopySchedule();
+        spriteMultiplexerScheduleReady = false;
+    }
+
+    spriteMultiplexerNextBand = 0;
+    SpriteMultiplexerKernel_SetTrigger(0);
+
+    // The VCount interrupts wrote straight to object attribute memory, so it no longer matches objectAttributeBuffer
+    objectAttributeBufferDirtyGroups |= SpriteMultiplexer_dirtyGroups;
+}
+
+void SpriteMultiplexer_Init(int firstSlot)
+{
+    static bool handlersAdded = false;
+
+    for (int i = 0; i < SpriteMultiplexer_MaxSprites; i++)
+    {
+        SpriteMultiplexer_nextFree[i] = i + 1;
+    }
+
+    SpriteMultiplexer_firstFree = 0;
+    spriteMultiplexerLiveCount = 0;
+    spriteMultiplexerFirstSlot = firstSlot;
+
+    spriteMultiplexerSchedule.bandCount = 0;
+    spriteMultiplexerNextSchedule.bandCount = 0;
+
+    spriteMultiplexerScheduleReady = false;
+    spriteMultiplexerNextBand = 0;
+
+    SpriteMultiplexer_dirtyGroups = 0;
+    for (int slot = firstSlot; slot < ObjectAttributeBuffer_Length; slot++)
+    {
+        objectAttributeBuffer[slot].attr0 = SPRITE_MULTIPLEXER_HIDDEN_ATTR0;
+        SpriteMultiplexer_dirtyGroups |= 1u << (slot / 4);
+    }
+
+    objectAttributeBufferDirtyGroups |= SpriteMultiplexer_dirtyGroups;
+
+    if (!handlersAdded)
+    {
+        // Slots have to be rewritten before the sprites in them start drawing, so go before anything else
+        Interrupt_AddHandler(InterruptType_VCount, SpriteMultiplexerKernel_VCount, -2);
+        // Copying the schedule takes a while, so let Sound and the others go first. The first band is never sooner
+        // than the end of vblank, so there is still plenty of time
+        Interrupt_AddHandler(InterruptType_VBlank, SpriteMultiplexer_vblank, 1);
+        handlersAdded = true;
+    }
+
+    SpriteMultiplexerKernel_SetTrigger(0);
+    Interrupt_EnableType(InterruptType_VCount);
+}
+
+SpriteMultiplexerHandle SpriteMultiplexer_Alloc(void)
+{
+    if (SpriteMultiplexer_firstFree == SpriteMultiplexer_MaxSprites)
+    {
+        return SpriteMultiplexer_InvalidHandle;
+    }
+
+    SpriteMultiplexerHandle handle = SpriteMultiplexer_firstFree;
+    SpriteMultiplexer_firstFree = SpriteMultiplexer_nextFree[handle];
+
+    SpriteMultiplexer_liveIndex[handle] = spriteMultiplexerLiveCount;
+    spriteMultiplexerLive[spriteMultiplexerLiveCount++] = handle;
+
+    struct ObjectAttribute *attr = &spriteMultiplexerAttributes[handle];
+    attr->attr0 = 0;
+    attr->attr1 = 0;
+    attr->attr2 = 0;
+
+    return handle;
+}
+
+void SpriteMultiplexer_Free(SpriteMultiplexerHandle handle)
+{
+    // Move the last live handle into the gap so spriteMultiplexerLive stays packed
+    int index = SpriteMultiplexer_liveIndex[handle];
+    int last = spriteMultiplexerLive[--spriteMultiplexerLiveCount];
+    spriteMultiplexerLive[index] = last;
+    SpriteMultiplexer_liveIndex[last] = index;
+
+    SpriteMultiplexer_nextFree[handle] = SpriteMultiplexer_firstFree;
+    SpriteMultiplexer_firstFree = handle;
+}
+
+struct ObjectAttribute *SpriteMultiplexer_GetAttribute(SpriteMultiplexerHandle handle)
+{
+    return &spriteMultiplexerAttributes[handle];
+}
+
+struct SpriteMultiplexerStats SpriteMultiplexer_GetStats(void)
+{
+    return spriteMultiplexerStats;
+}
+
+const u32 *SpriteMultiplexer_GetLineCycles(void)
+{
+    return spriteMultiplexerLineCycles;
+}
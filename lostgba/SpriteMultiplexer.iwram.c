@@ -0,0 +1,349 @@
+// The sprite multiplexer's sort and the VCount handler which rewrites slots mid frame. Both are on the critical
+// path every frame, so they are compiled as ARM code and run from IWRAM (see the *.iwram.c rule in the Makefile).
+
+#include "SpriteMultiplexerInternal.h"
+#include "LostGbaInternal.h"
+
+#define SPRITE_MULTIPLEXER_DISPLAY_STATUS ((vu16 *)LOSTGBA_ADDRESS(0x04000004))
+#define SPRITE_MULTIPLEXER_OAM ((vu16 *)LOSTGBA_ADDRESS(0x07000000))
+
+// attr0 of a hidden sprite, see ObjectAttributeDisplayMode_Hidden
+#define SPRITE_MULTIPLEXER_HIDDEN_ATTR0 (ObjectAttributeDisplayMode_Hidden << 8)
+
+// A sprite written by the interrupt at the start of a band must start at least this many lines below it. The
+// hardware works out which sprites are on each line during the line before, so this leaves that whole line for the
+// interrupt to finish writing.
+#define SPRITE_MULTIPLEXER_LEAD_LINES 2
+
+// The highest a sprite can start. A 64x64 sprite with a double size render area is 128 lines tall
+#define SPRITE_MULTIPLEXER_MIN_TOP (-128)
+#define SPRITE_MULTIPLEXER_TOP_BUCKETS (Graphics_ScreenHeight - SPRITE_MULTIPLEXER_MIN_TOP)
+
+#define SPRITE_MULTIPLEXER_NO_SLOT 0xff
+
+// Sprite sizes in pixels, indexed by [shape][size]
+static const u8 SpriteMultiplexer_widths[3][4] = {
+    {8, 16, 32, 64},
+    {16, 32, 32, 64},
+    {8, 8, 16, 32},
+};
+static const u8 SpriteMultiplexer_heights[3][4] = {
+    {8, 16, 32, 64},
+    {8, 8, 16, 32},
+    {16, 32, 32, 64},
+};
+
+// Scratch space for SpriteMultiplexer_Commit()
+static u16 SpriteMultiplexer_sorted[SpriteMultiplexer_MaxSprites];
+static u16 SpriteMultiplexer_topStarts[SPRITE_MULTIPLEXER_TOP_BUCKETS];
+static s32 SpriteMultiplexer_lineDeltas[Graphics_ScreenHeight + 1];
+
+// Slots which can be reused in the current band
+static u8 SpriteMultiplexer_freeSlots[ObjectAttributeBuffer_Length];
+// Lists of slots, by the line their sprite ends on, linked through SpriteMultiplexer_nextFreeAt
+static u8 SpriteMultiplexer_freeAtHeads[Graphics_ScreenHeight];
+static u8 SpriteMultiplexer_nextFreeAt[ObjectAttributeBuffer_Length];
+
+struct SpriteMultiplexerSchedule spriteMultiplexerSchedule;
+
+void SpriteMultiplexerKernel_SetTrigger(int band)
+{
+    const struct SpriteMultiplexerSchedule *schedule = &spriteMultiplexerSchedule;
+    int line = band < schedule->bandCount ? schedule->bandLines[band] : SPRITE_MULTIPLEXER_NO_BAND;
+
+    *SPRITE_MULTIPLEXER_DISPLAY_STATUS = (*SPRITE_MULTIPLEXER_DISPLAY_STATUS & 0x00ff) | (line << 8);
+}
+
+void SpriteMultiplexerKernel_CopySchedule(void)
+{
+    const struct SpriteMultiplexerSchedule *from = &spriteMultiplexerNextSchedule;
+    struct SpriteMultiplexerSchedule *to = &spriteMultiplexerSchedule;
+
+    int bandCount = from->bandCount;
+    int writeCount = bandCount ? from->bandEnds[bandCount - 1] : 0;
+
+    to->bandCount = bandCount;
+    for (int i = 0; i < bandCount; i++)
+    {
+        to->bandLines[i] = from->bandLines[i];
+        to->bandEnds[i] = from->bandEnds[i];
+    }
+
+    for (int i = 0; i < writeCount; i++)
+    {
+        to->writes[i] = from->writes[i];
+    }
+}
+
+void SpriteMultiplexerKernel_VCount(void)
+{
+    const struct SpriteMultiplexerSchedule *schedule = &spriteMultiplexerSchedule;
+    int band = spriteMultiplexerNextBand;
+
+    if (band >= schedule->bandCount)
+    {
+        return;
+    }
+
+    // attr0 and attr1 go in one 32 bit store. The affine data interlaced with attr2 is left alone
+    vu16 *oam = SPRITE_MULTIPLEXER_OAM;
+    int end = schedule->bandEnds[band];
+    for (int i = band ? schedule->bandEnds[band - 1] : 0; i < end; i++)
+    {
+        const struct SpriteMultiplexerWrite *write = &schedule->writes[i];
+        vu16 *slot = &oam[write->slot * 4];
+
+        *(vu32 *)slot = write->attr01;
+        slot[2] = write->attr2;
+    }
+
+    spriteMultiplexerNextBand = band + 1;
+    SpriteMultiplexerKernel_SetTrigger(band + 1);
+}
+
+// Works out the lines attr covers and how many cycles it costs on each of them. Returns false if it isn't on screen
+static inline bool SpriteMultiplexer_bounds(const struct ObjectAttribute *attr, int *top, int *bottom, int *cycles)
+{
+    u32 attr0 = attr->attr0;
+    u32 attr1 = attr->attr1;
+
+    u32 displayMode = (attr0 >> 8) & 3;
+    u32 shape = attr0 >> 14;
+    if (displayMode == ObjectAttributeDisplayMode_Hidden || shape > ObjectAttributeShape_Tall)
+    {
+        return false;
+    }
+
+    u32 size = attr1 >> 14;
+    int width = SpriteMultiplexer_widths[shape][size];
+    int height = SpriteMultiplexer_heights[shape][size];
+
+    if (displayMode == ObjectAttributeDisplayMode_DoubleRender)
+    {
+        width *= 2;
+        height *= 2;
+    }
+
+    // Coordinates wrap around, so sprites hanging off the bottom or right of the coordinate space come back in at
+    // the top or left
+    int y = attr0 & 0xff;
+    if (y + height > 256)
+    {
+        y -= 256;
+    }
+
+    int x = attr1 & 0x1ff;
+    if (x + width > 512)
+    {
+        x -= 512;
+    }
+
+    if (y >= Graphics_ScreenHeight || x >= Graphics_ScreenWidth)
+    {
+        return false;
+    }
+
+    *top = y;
+    *bottom = y + height;
+    *cycles = displayMode == ObjectAttributeDisplayMode_Normal ? width : 10 + 2 * width;
+    return true;
+}
+
+// Sorts the visible virtual sprites into SpriteMultiplexer_sorted by their top line. Returns how many there are
+static int SpriteMultiplexer_sortByTop(void)
+{
+    int count = spriteMultiplexerLiveCount;
+    int top, bottom, cycles;
+
+    for (int i = 0; i < SPRITE_MULTIPLEXER_TOP_BUCKETS; i++)
+    {
+        SpriteMultiplexer_topStarts[i] = 0;
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        if (SpriteMultiplexer_bounds(&spriteMultiplexerAttributes[spriteMultiplexerLive[i]], &top, &bottom, &cycles))
+        {
+            SpriteMultiplexer_topStarts[top - SPRITE_MULTIPLEXER_MIN_TOP]++;
+        }
+    }
+
+    int total = 0;
+    for (int i = 0; i < SPRITE_MULTIPLEXER_TOP_BUCKETS; i++)
+    {
+        int bucketCount = SpriteMultiplexer_topStarts[i];
+        SpriteMultiplexer_topStarts[i] = total;
+        total += bucketCount;
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        int handle = spriteMultiplexerLive[i];
+        if (SpriteMultiplexer_bounds(&spriteMultiplexerAttributes[handle], &top, &bottom, &cycles))
+        {
+            SpriteMultiplexer_sorted[SpriteMultiplexer_topStarts[top - SPRITE_MULTIPLEXER_MIN_TOP]++] = handle;
+        }
+    }
+
+    return total;
+}
+
+static void SpriteMultiplexer_updateLineStats(int visibleSprites, int droppedSprites, int bandCount)
+{
+    struct SpriteMultiplexerStats stats = {
+        .visibleSprites = visibleSprites,
+        .droppedSprites = droppedSprites,
+        .bandCount = bandCount,
+    };
+
+    s32 cycles = 0;
+    for (int line = 0; line < Graphics_ScreenHeight; line++)
+    {
+        cycles += SpriteMultiplexer_lineDeltas[line];
+        spriteMultiplexerLineCycles[line] = cycles;
+
+        if (cycles > SpriteMultiplexer_LineCycleBudget)
+        {
+            stats.overflowLines++;
+        }
+
+        if (cycles > stats.worstLineCycles)
+        {
+            stats.worstLine = line;
+            stats.worstLineCycles = cycles;
+        }
+    }
+
+    spriteMultiplexerStats = stats;
+}
+
+void SpriteMultiplexer_Commit(void)
+{
+    // Stop the vblank handler swapping in the back schedule while it is being rebuilt
+    spriteMultiplexerScheduleReady = false;
+    struct SpriteMultiplexerSchedule *schedule = &spriteMultiplexerNextSchedule;
+
+    int visibleSprites = SpriteMultiplexer_sortByTop();
+
+    int firstSlot = spriteMultiplexerFirstSlot;
+    int slotCount = ObjectAttributeBuffer_Length - firstSlot;
+    int freshSlots = 0;
+    int freeSlotCount = 0;
+    int nextFreeLine = 0;
+
+    for (int line = 0; line < Graphics_ScreenHeight; line++)
+    {
+        SpriteMultiplexer_freeAtHeads[line] = SPRITE_MULTIPLEXER_NO_SLOT;
+        SpriteMultiplexer_lineDeltas[line] = 0;
+    }
+    SpriteMultiplexer_lineDeltas[Graphics_ScreenHeight] = 0;
+
+    int writeCount = 0;
+    int bandCount = 0;
+    int bandStart = 0;
+    int droppedSprites = 0;
+
+    for (int i = 0; i < visibleSprites; i++)
+    {
+        const struct ObjectAttribute *attr = &spriteMultiplexerAttributes[SpriteMultiplexer_sorted[i]];
+        int top = 0, bottom = 0, cycles = 0;
+        SpriteMultiplexer_bounds(attr, &top, &bottom, &cycles);
+
+        int slot;
+        if (freshSlots < slotCount)
+        {
+            // The topmost sprites are there from the start of the frame
+            slot = firstSlot + freshSlots++;
+
+            struct ObjectAttribute *destination = &objectAttributeBuffer[slot];
+            destination->attr0 = attr->attr0;
+            destination->attr1 = attr->attr1;
+            destination->attr2 = attr->attr2;
+        }
+        else
+        {
+            int bandLine = top - SPRITE_MULTIPLEXER_LEAD_LINES;
+            if (bandLine < 0)
+            {
+                droppedSprites++;
+                continue;
+            }
+
+            bandLine -= bandLine % SpriteMultiplexer_BandHeight;
+
+            bool newBand = bandCount == 0 || schedule->bandLines[bandCount - 1] != bandLine;
+            if (!newBand && writeCount - bandStart == SpriteMultiplexer_MaxWritesPerBand)
+            {
+                // Any more and the interrupt could still be copying when the hardware starts on this sprite
+                droppedSprites++;
+                continue;
+            }
+
+            // Sprites come in order of their top line, so the band only ever moves down and every slot which has
+            // become free by now stays free for the rest of the frame
+            for (; nextFreeLine <= bandLine; nextFreeLine++)
+            {
+                for (int free = SpriteMultiplexer_freeAtHeads[nextFreeLine]; free != SPRITE_MULTIPLEXER_NO_SLOT;
+                     free = SpriteMultiplexer_nextFreeAt[free])
+                {
+                    SpriteMultiplexer_freeSlots[freeSlotCount++] = free;
+                }
+            }
+
+            if (freeSlotCount == 0)
+            {
+                droppedSprites++;
+                continue;
+            }
+
+            slot = SpriteMultiplexer_freeSlots[--freeSlotCount];
+
+            if (newBand)
+            {
+                if (bandCount > 0)
+                {
+                    schedule->bandEnds[bandCount - 1] = writeCount;
+                }
+
+                schedule->bandLines[bandCount++] = bandLine;
+                bandStart = writeCount;
+            }
+
+            struct SpriteMultiplexerWrite *write = &schedule->writes[writeCount++];
+            write->attr01 = attr->attr0 | ((u32)attr->attr1 << 16);
+            write->attr2 = attr->attr2;
+            write->slot = slot;
+        }
+
+        // Slots whose sprite runs off the bottom of the screen can't be used again this frame
+        if (bottom < Graphics_ScreenHeight)
+        {
+            SpriteMultiplexer_nextFreeAt[slot] = SpriteMultiplexer_freeAtHeads[bottom];
+            SpriteMultiplexer_freeAtHeads[bottom] = slot;
+        }
+
+        SpriteMultiplexer_lineDeltas[top > 0 ? top : 0] += cycles;
+        SpriteMultiplexer_lineDeltas[bottom < Graphics_ScreenHeight ? bottom : Graphics_ScreenHeight] -= cycles;
+    }
+
+    if (bandCount > 0)
+    {
+        schedule->bandEnds[bandCount - 1] = writeCount;
+    }
+    schedule->bandCount = bandCount;
+
+    for (int slot = firstSlot + freshSlots; slot < ObjectAttributeBuffer_Length; slot++)
+    {
+        objectAttributeBuffer[slot].attr0 = SPRITE_MULTIPLEXER_HIDDEN_ATTR0;
+    }
+
+    // Every slot gets uploaded at vblank anyway, since the interrupts overwrite them in object attribute memory
+    if (firstSlot < ObjectAttributeBuffer_Length)
+    {
+        objectAttributeBufferDirtyGroups |= ~0u << (firstSlot / 4);
+    }
+
+    SpriteMultiplexer_updateLineStats(visibleSprites, droppedSprites, bandCount);
+
+    spriteMultiplexerScheduleReady = true;
+}
@@ -0,0 +1,63 @@
+/**
+ * @file SpriteMultiplexerInternal.h
+ */
+
+#pragma once
+
+#include <lostgba/SpriteMultiplexer.h>
+#include <lostgba/Graphics.h>
+
+/** The VCount trigger used when there are no more bands this frame. Never matches, since the last line is 227 */
+#define SPRITE_MULTIPLEXER_NO_BAND 0xff
+
+/** A virtual sprite to copy into a slot part way down the screen */
+struct SpriteMultiplexerWrite
+{
+    /** attr0 in the low half and attr1 in the high half, so they can be written together */
+    u32 attr01;
+    u16 attr2;
+    u8 slot;
+};
+
+/** Everything the VCount interrupts need to rewrite the slots during one frame */
+struct SpriteMultiplexerSchedule
+{
+    int bandCount;
+    /** The line each band's interrupt fires at */
+    u8 bandLines[SpriteMultiplexer_MaxBands];
+    /** The index in writes after each band's last write */
+    u16 bandEnds[SpriteMultiplexer_MaxBands];
+    struct SpriteMultiplexerWrite writes[SpriteMultiplexer_MaxSprites];
+};
+
+// Shared between SpriteMultiplexer.c and SpriteMultiplexer.iwram.c
+
+/** The attributes of every virtual sprite, indexed by handle */
+extern struct ObjectAttribute spriteMultiplexerAttributes[SpriteMultiplexer_MaxSprites];
+
+/** The allocated handles, packed at the start */
+extern u16 spriteMultiplexerLive[SpriteMultiplexer_MaxSprites];
+extern int spriteMultiplexerLiveCount;
+
+extern int spriteMultiplexerFirstSlot;
+
+/** The schedule the VCount interrupts are working through this frame. In IWRAM, since they read it every band */
+extern struct SpriteMultiplexerSchedule spriteMultiplexerSchedule;
+/** Built by SpriteMultiplexer_Commit(), and copied into spriteMultiplexerSchedule at vblank */
+extern struct SpriteMultiplexerSchedule spriteMultiplexerNextSchedule;
+/** Set by SpriteMultiplexer_Commit() once spriteMultiplexerNextSchedule is ready to be copied at vblank */
+extern volatile bool spriteMultiplexerScheduleReady;
+/** The next band of spriteMultiplexerSchedule */
+extern volatile int spriteMultiplexerNextBand;
+
+extern struct SpriteMultiplexerStats spriteMultiplexerStats;
+extern u32 spriteMultiplexerLineCycles[Graphics_ScreenHeight];
+
+/** Sets the line the VCount interrupt fires at to the line of @p band in spriteMultiplexerSchedule */
+void SpriteMultiplexerKernel_SetTrigger(int band);
+
+/** Copies spriteMultiplexerNextSchedule into spriteMultiplexerSchedule. Only the writes actually used are copied */
+void SpriteMultiplexerKernel_CopySchedule(void);
+
+/** The VCount handler. Copies the next band of writes into object attribute memory */
+void SpriteMultiplexerKernel_VCount(void);
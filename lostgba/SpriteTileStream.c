@@ -0,0 +1,87 @@
+#include <lostgba/SpriteTileStream.h>
+#include <lostgba/Dma.h>
+
+#include "LostGbaInternal.h"
+
+#define SPRITE_TILE_MEMORY_LOCATION ((u32 *)LOSTGBA_ADDRESS(0x06010000))
+#define TILE_4BPP_WORDS 8
+
+static struct SpriteTileStream *SpriteTileStream_queue[SpriteTileStream_MaxQueued];
+static int SpriteTileStream_queueLength = 0;
+
+static bool SpriteTileStream_enqueue(struct SpriteTileStream *stream)
+{
+    if (stream->queued)
+    {
+        return true;
+    }
+
+    if (SpriteTileStream_queueLength == SpriteTileStream_MaxQueued)
+    {
+        return false;
+    }
+
+    stream->queued = true;
+    SpriteTileStream_queue[SpriteTileStream_queueLength++] = stream;
+    return true;
+}
+
+void SpriteTileStream_Init(struct SpriteTileStream *stream, const void *sheet, int tilesPerFrame, int vramTile)
+{
+    stream->sheet = sheet;
+    stream->tilesPerFrame = tilesPerFrame;
+    stream->vramTile = vramTile;
+    stream->frame = 0;
+
+    // A stream which is set up again may still be waiting in the queue, and mustn't be added to it twice. queued
+    // can't be trusted on a stream which has never been set up, so look through the queue instead
+    stream->queued = false;
+    for (int i = 0; i < SpriteTileStream_queueLength; i++)
+    {
+        if (SpriteTileStream_queue[i] == stream)
+        {
+            stream->queued = true;
+            break;
+        }
+    }
+
+    if (!SpriteTileStream_enqueue(stream))
+    {
+        // Nothing has been shown yet, so make sure the first SpriteTileStream_SetFrame() isn't skipped
+        stream->frame = -1;
+    }
+}
+
+bool SpriteTileStream_SetFrame(struct SpriteTileStream *stream, int frame)
+{
+    if (stream->frame == frame)
+    {
+        return true;
+    }
+
+    // If it's already queued, the copy will just pick up the new frame
+    if (!SpriteTileStream_enqueue(stream))
+    {
+        return false;
+    }
+
+    stream->frame = frame;
+    return true;
+}
+
+void SpriteTileStream_Flush(void)
+{
+    for (int i = 0; i < SpriteTileStream_queueLength; i++)
+    {
+        struct SpriteTileStream *stream = SpriteTileStream_queue[i];
+        u32 words = stream->tilesPerFrame * TILE_4BPP_WORDS;
+
+        Dma_Copy32(stream->sheet + stream->frame * words,
+                   SPRITE_TILE_MEMORY_LOCATION + stream->vramTile * TILE_4BPP_WORDS,
+                   words);
+
+        stream->queued = false;
+    }
+
+    SpriteTileStream_queueLength = 0;
+}
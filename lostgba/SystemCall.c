@@ -1,22 +1,124 @@
 #include <lostgba/SystemCalls.h>
 
 #ifdef __thumb__
-#define swi_call(x)                                 \
-    do                                              \
-    {                                               \
-        asm volatile("swi\t" #x ::                  \
-                         : "r0", "r1", "r2", "r3"); \
-    } while (0)
+#define swi_instruction(x) "swi\t" #x
 #else
+#define swi_instruction(x) "swi\t" #x "<<16"
+#endif
+
 #define swi_call(x)                                 \
     do                                              \
     {                                               \
-        asm volatile("swi\t" #x "<<16" ::           \
+        asm volatile(swi_instruction(x)::           \
                          : "r0", "r1", "r2", "r3"); \
     } while (0)
-#endif
+
+// Calls a BIOS function which reads r0 - r2 and writes to memory
+#define swi_call3(x, arg0, arg1, arg2)                                    \
+    do                                                                    \
+    {                                                                     \
+        register u32 r0 asm("r0") = (u32)(arg0);                          \
+        register u32 r1 asm("r1") = (u32)(arg1);                          \
+        register u32 r2 asm("r2") = (u32)(arg2);                          \
+        asm volatile(swi_instruction(x)                                   \
+                     : "+r"(r0), "+r"(r1), "+r"(r2)::"r3", "memory");     \
+    } while (0)
+
+void SystemCall_Halt(void)
+{
+    swi_call(0x02);
+}
+
+void SystemCall_IntrWait(bool discardOldFlags, u16 interruptFlags)
+{
+    swi_call3(0x04, discardOldFlags, interruptFlags, 0);
+}
 
 void SystemCall_WaitForVBlank(void)
 {
     swi_call(0x05);
-}
\ No newline at end of file
+}
+
+s32 SystemCall_DivMod(s32 numerator, s32 denominator, s32 *remainder)
+{
+    register s32 r0 asm("r0") = numerator;
+    register s32 r1 asm("r1") = denominator;
+
+    asm(swi_instruction(0x06)
+        : "+r"(r0), "+r"(r1)::"r2", "r3");
+
+    *remainder = r1;
+    return r0;
+}
+
+s32 SystemCall_Div(s32 numerator, s32 denominator)
+{
+    s32 remainder;
+    return SystemCall_DivMod(numerator, denominator, &remainder);
+}
+
+s32 SystemCall_Mod(s32 numerator, s32 denominator)
+{
+    s32 remainder;
+    SystemCall_DivMod(numerator, denominator, &remainder);
+    return remainder;
+}
+
+u16 SystemCall_Sqrt(u32 value)
+{
+    register u32 r0 asm("r0") = value;
+
+    asm(swi_instruction(0x08)
+        : "+r"(r0)::"r1", "r2", "r3");
+
+    return r0;
+}
+
+u16 SystemCall_ArcTan2(s16 x, s16 y)
+{
+    register s32 r0 asm("r0") = x;
+    register s32 r1 asm("r1") = y;
+
+    asm(swi_instruction(0x0A)
+        : "+r"(r0), "+r"(r1)::"r2", "r3");
+
+    return r0;
+}
+
+void SystemCall_CpuSet(const void *source, void *destination, u32 count, enum SystemCallCpuSetMode mode)
+{
+    bool fill = mode == SystemCallCpuSetMode_Fill16 || mode == SystemCallCpuSetMode_Fill32;
+    bool words = mode == SystemCallCpuSetMode_Copy32 || mode == SystemCallCpuSetMode_Fill32;
+
+    swi_call3(0x0B, source, destination, (count & 0x1fffff) | (fill << 24) | (words << 26));
+}
+
+void SystemCall_CpuFastSet(const void *source, void *destination, u32 wordCount, bool fill)
+{
+    swi_call3(0x0C, source, destination, (wordCount & 0x1fffff) | (fill << 24));
+}
+
+void SystemCall_LZ77UnCompWram(const void *source, void *destination)
+{
+    swi_call3(0x11, source, destination, 0);
+}
+
+void SystemCall_LZ77UnCompVram(const void *source, volatile void *destination)
+{
+    swi_call3(0x12, source, destination, 0);
+}
+
+void SystemCall_HuffUnComp(const void *source, volatile void *destination)
+{
+    swi_call3(0x13, source, destination, 0);
+}
+
+void SystemCall_RLUnCompWram(const void *source, void *destination)
+{
+    swi_call3(0x14, source, destination, 0);
+}
+
+void SystemCall_RLUnCompVram(const void *source, volatile void *destination)
+{
+    swi_call3(0x15, source, destination, 0);
+}
@@ -0,0 +1,338 @@
+#include <lostgba/Text.h>
+#include <lostgba/Dma.h>
+
+#include "LostGbaInternal.h"
+
+#define TEXT_TILE_MEMORY_LOCATION ((u32 *)LOSTGBA_ADDRESS(0x06000000))
+#define TEXT_CHARBLOCK_TILES 512
+#define TEXT_TILE_WORDS 8
+
+#define TEXT_NO_GLYPH 0xff
+
+// The longest run of screen entries written at once. Longer rows are written in several goes
+#define TEXT_MAX_ROW_LENGTH 64
+
+static u32 *Text_tileAddress(int tileBlock, int tile)
+{
+    return TEXT_TILE_MEMORY_LOCATION + (tileBlock * TEXT_CHARBLOCK_TILES + tile) * TEXT_TILE_WORDS;
+}
+
+// The glyph index for character, or TEXT_NO_GLYPH if the font doesn't have one
+static int Text_glyphIndex(const struct TextFont *font, char character)
+{
+    u32 index = (u8)character - font->firstCharacter;
+    return index < font->glyphCount ? (int)index : TEXT_NO_GLYPH;
+}
+
+static int Text_glyphWidth(const struct TextFont *font, int glyph)
+{
+    return font->widths ? font->widths[glyph] : 8;
+}
+
+// Spreads the 8 bits of a glyph row out to the bottom bit of each nibble of a 4bpp tile row. Bit 0 of the glyph
+// is the leftmost pixel, which is also the lowest nibble.
+static u32 Text_expandRow(u32 bits)
+{
+    bits = (bits | (bits << 12)) & 0x000f000fu;
+    bits = (bits | (bits << 6)) & 0x03030303u;
+    bits = (bits | (bits << 3)) & 0x11111111u;
+    return bits;
+}
+
+int Text_MeasureWidth(const struct TextFont *font, const char *text)
+{
+    int width = 0;
+    for (; *text; text++)
+    {
+        int glyph = Text_glyphIndex(font, *text);
+        width += glyph == TEXT_NO_GLYPH ? Text_glyphWidth(font, 0) : Text_glyphWidth(font, glyph);
+    }
+
+    return width;
+}
+
+void TextLayer_Init(struct TextLayer *layer, const struct TextFont *font, struct TextLayerSettings settings)
+{
+    if (settings.cachedGlyphs > TextLayer_MaxCachedGlyphs)
+    {
+        settings.cachedGlyphs = TextLayer_MaxCachedGlyphs;
+    }
+
+    layer->font = font;
+    layer->settings = settings;
+    layer->clock = 0;
+
+    for (int i = 0; i < TextLayer_MaxCachedGlyphs; i++)
+    {
+        layer->slotGlyph[i] = TEXT_NO_GLYPH;
+        layer->slotLastUsed[i] = 0;
+    }
+
+    for (int i = 0; i < 256; i++)
+    {
+        layer->glyphSlot[i] = 0;
+    }
+
+    Dma_Fill32(0, Text_tileAddress(settings.tileBlock, settings.firstTile), TEXT_TILE_WORDS);
+}
+
+static void TextLayer_uploadGlyph(struct TextLayer *layer, int glyph, int slot)
+{
+    const struct TextFont *font = layer->font;
+    const u8 *rows = &font->glyphs[glyph * Text_GlyphHeight];
+    u32 *tile = Text_tileAddress(layer->settings.tileBlock, layer->settings.firstTile + 1 + slot);
+
+    // Centre narrow glyphs in their tile
+    int shift = ((8 - Text_glyphWidth(font, glyph)) / 2) * 4;
+    if (shift < 0)
+    {
+        shift = 0;
+    }
+
+    for (int row = 0; row < Text_GlyphHeight; row++)
+    {
+        tile[row] = (Text_expandRow(rows[row]) * layer->settings.colour) << shift;
+    }
+}
+
+// Returns the tile for glyph, uploading it into the least recently used slot if it isn't cached yet
+static int TextLayer_glyphTile(struct TextLayer *layer, int glyph)
+{
+    int slot = layer->glyphSlot[glyph] - 1;
+
+    if (slot < 0)
+    {
+        slot = 0;
+        for (int i = 1; i < layer->settings.cachedGlyphs; i++)
+        {
+            if (layer->slotLastUsed[i] < layer->slotLastUsed[slot])
+            {
+                slot = i;
+            }
+        }
+
+        if (layer->slotGlyph[slot] != TEXT_NO_GLYPH)
+        {
+            layer->glyphSlot[layer->slotGlyph[slot]] = 0;
+        }
+
+        layer->slotGlyph[slot] = glyph;
+        layer->glyphSlot[glyph] = slot + 1;
+        TextLayer_uploadGlyph(layer, glyph, slot);
+    }
+
+    layer->slotLastUsed[slot] = layer->clock;
+    return layer->settings.firstTile + 1 + slot;
+}
+
+static u16 TextLayer_screenEntry(struct TextLayer *layer, char character)
+{
+    int glyph = Text_glyphIndex(layer->font, character);
+    int tile = layer->settings.firstTile;
+
+    // Spaces (and anything not in the font) use the blank tile rather than taking up a slot
+    if (glyph != TEXT_NO_GLYPH && character != ' ' && layer->settings.cachedGlyphs > 0)
+    {
+        tile = TextLayer_glyphTile(layer, glyph);
+    }
+
+    return Background_MakeScreenEntry(tile, false, false, layer->settings.paletteBank);
+}
+
+static void TextLayer_writeRow(struct TextLayer *layer, int x, int y, const u16 *entries, int length)
+{
+    if (length > 0)
+    {
+        LOSTGBA_UNSAFE(Background_SetRow)
+        (layer->settings.screenBaseBlock, layer->settings.backgroundSize, x, y, entries, length);
+    }
+}
+
+void TextLayer_Print(struct TextLayer *layer, int x, int y, const char *text)
+{
+    u16 entries[TEXT_MAX_ROW_LENGTH];
+    int length = 0;
+    int rowX = x;
+
+    layer->clock++;
+
+    for (; *text; text++)
+    {
+        if (*text == '\n')
+        {
+            TextLayer_writeRow(layer, rowX, y, entries, length);
+            length = 0;
+            rowX = x;
+            y++;
+            continue;
+        }
+
+        entries[length++] = TextLayer_screenEntry(layer, *text);
+
+        if (length == TEXT_MAX_ROW_LENGTH)
+        {
+            TextLayer_writeRow(layer, rowX, y, entries, length);
+            rowX += length;
+            length = 0;
+        }
+    }
+
+    TextLayer_writeRow(layer, rowX, y, entries, length);
+}
+
+// Writes value right aligned into the width characters before end, padded with spaces
+static void Text_formatNumber(char *end, int width, s32 value)
+{
+    u32 magnitude = value < 0 ? -(u32)value : (u32)value;
+    char *position = end;
+
+    do
+    {
+        *--position = '0' + magnitude % 10;
+        magnitude /= 10;
+    } while (magnitude && position > end - width);
+
+    if (value < 0 && position > end - width)
+    {
+        *--position = '-';
+    }
+
+    while (position > end - width)
+    {
+        *--position = ' ';
+    }
+}
+
+// Enough for any s32 with a sign
+#define TEXT_MAX_NUMBER_WIDTH 11
+
+void TextLayer_PrintNumber(struct TextLayer *layer, int x, int y, s32 value, int width)
+{
+    char buffer[TEXT_MAX_NUMBER_WIDTH + 1];
+
+    if (width > TEXT_MAX_NUMBER_WIDTH)
+    {
+        x += width - TEXT_MAX_NUMBER_WIDTH;
+        width = TEXT_MAX_NUMBER_WIDTH;
+    }
+
+    if (width <= 0)
+    {
+        return;
+    }
+
+    buffer[width] = '\0';
+    Text_formatNumber(&buffer[width], width, value);
+    TextLayer_Print(layer, x, y, buffer);
+}
+
+void TextLayer_Clear(struct TextLayer *layer, int x, int y, int width, int height)
+{
+    LOSTGBA_UNSAFE(Background_FillRect)
+    (layer->settings.screenBaseBlock, layer->settings.backgroundSize, x, y, width, height,
+     Background_MakeScreenEntry(layer->settings.firstTile, false, false, layer->settings.paletteBank));
+}
+
+void TextLabel_Init(struct TextLabel *label, const struct TextFont *font, struct TextLabelSettings settings)
+{
+    if (settings.widthInTiles > TextLabel_MaxTiles)
+    {
+        settings.widthInTiles = TextLabel_MaxTiles;
+    }
+
+    label->font = font;
+    label->settings = settings;
+    label->text[0] = '\0';
+
+    u16 entries[TextLabel_MaxTiles];
+    for (int i = 0; i < settings.widthInTiles; i++)
+    {
+        entries[i] = Background_MakeScreenEntry(settings.firstTile + i, false, false, settings.paletteBank);
+    }
+
+    LOSTGBA_UNSAFE(Background_SetRow)
+    (settings.screenBaseBlock, settings.backgroundSize, settings.x, settings.y, entries, settings.widthInTiles);
+    Dma_Fill32(0, Text_tileAddress(settings.tileBlock, settings.firstTile), settings.widthInTiles * TEXT_TILE_WORDS);
+}
+
+// Returns whether text (up to TextLabel_MaxLength characters) is different to the label's, and copies it over
+static bool TextLabel_updateText(struct TextLabel *label, const char *text)
+{
+    bool changed = false;
+    int i = 0;
+
+    for (; i < TextLabel_MaxLength && text[i]; i++)
+    {
+        changed |= label->text[i] != text[i];
+        label->text[i] = text[i];
+    }
+
+    changed |= label->text[i] != '\0';
+    label->text[i] = '\0';
+
+    return changed;
+}
+
+void TextLabel_Set(struct TextLabel *label, const char *text)
+{
+    if (!TextLabel_updateText(label, text))
+    {
+        return;
+    }
+
+    // One spare tile, so a glyph spilling over the right edge doesn't need checking for
+    u32 pixels[(TextLabel_MaxTiles + 1) * TEXT_TILE_WORDS];
+    int widthInPixels = label->settings.widthInTiles * 8;
+
+    for (int i = 0; i < label->settings.widthInTiles * TEXT_TILE_WORDS; i++)
+    {
+        pixels[i] = 0;
+    }
+
+    const struct TextFont *font = label->font;
+    u32 colour = label->settings.colour;
+    int x = 0;
+
+    for (const char *character = label->text; *character; character++)
+    {
+        int glyph = Text_glyphIndex(font, *character);
+        if (glyph == TEXT_NO_GLYPH)
+        {
+            x += Text_glyphWidth(font, 0);
+            continue;
+        }
+
+        int width = Text_glyphWidth(font, glyph);
+        if (x + width > widthInPixels)
+        {
+            break;
+        }
+
+        const u8 *rows = &font->glyphs[glyph * Text_GlyphHeight];
+        u32 *left = &pixels[(x / 8) * TEXT_TILE_WORDS];
+        u32 *right = left + TEXT_TILE_WORDS;
+        int shift = (x % 8) * 4;
+
+        if (shift == 0)
+        {
+            for (int row = 0; row < Text_GlyphHeight; row++)
+            {
+                left[row] |= Text_expandRow(rows[row]) * colour;
+            }
+        }
+        else
+        {
+            for (int row = 0; row < Text_GlyphHeight; row++)
+            {
+                u32 pixelRow = Text_expandRow(rows[row]) * colour;
+                left[row] |= pixelRow << shift;
+                right[row] |= pixelRow >> (32 - shift);
+            }
+        }
+
+        x += width;
+    }
+
+    Dma_Copy32(pixels, Text_tileAddress(label->settings.tileBlock, label->settings.firstTile),
+               label->settings.widthInTiles * TEXT_TILE_WORDS);
+}
@@ -1,32 +1,52 @@
 #include <lostgba/TileMap.h>
+#include <lostgba/Dma.h>
+#include "LostGbaInternal.h"
 
-#include <string.h>
-
-#define SPRITE_PALETTE_MEMORY_LOCATION ((u16 *)0x05000200)
+#define SPRITE_PALETTE_MEMORY_LOCATION ((u16 *)LOSTGBA_ADDRESS(0x05000200))
 
 void TileMap_CopyToSpritePalette(const u16 paletteData[TileMap_PaletteLength])
 {
-    memcpy(SPRITE_PALETTE_MEMORY_LOCATION, paletteData, TileMap_PaletteLength * sizeof(u16));
+    Dma_Copy32(paletteData, SPRITE_PALETTE_MEMORY_LOCATION, TileMap_PaletteLength * sizeof(u16) / sizeof(u32));
+}
+
+void TileMap_LoadCompressedSpritePalette(const void *compressedPaletteData)
+{
+    LostGBA_Decompress(compressedPaletteData, SPRITE_PALETTE_MEMORY_LOCATION, true);
 }
 
-#define SPRITE_CHARBLOCK_BASE ((u16 *)0x06010000)
+#define SPRITE_CHARBLOCK_BASE ((u8 *)LOSTGBA_ADDRESS(0x06010000))
 #define CHARBLOCK_SIZE 0x4000
 
 void LOSTGBA_UNSAFE(TileMap_CopyToSpriteTiles)(int tileNumber, const unsigned int *tileData, int length)
 {
-    memcpy(SPRITE_CHARBLOCK_BASE + tileNumber * CHARBLOCK_SIZE, tileData, length);
+    Dma_Copy(tileData, SPRITE_CHARBLOCK_BASE + tileNumber * CHARBLOCK_SIZE, length);
+}
+
+void LOSTGBA_UNSAFE(TileMap_LoadCompressedSpriteTiles)(int tileNumber, const void *compressedTileData)
+{
+    LostGBA_Decompress(compressedTileData, SPRITE_CHARBLOCK_BASE + tileNumber * CHARBLOCK_SIZE, true);
 }
 
-#define BG_PALETTE_MEMORY_LOCATION ((u16 *)0x05000000)
+#define BG_PALETTE_MEMORY_LOCATION ((u16 *)LOSTGBA_ADDRESS(0x05000000))
 
 void TileMap_CopyToBackgroundPalette(const u16 paletteData[TileMap_PaletteLength])
 {
-    memcpy(BG_PALETTE_MEMORY_LOCATION, paletteData, TileMap_PaletteLength * sizeof(u16));
+    Dma_Copy32(paletteData, BG_PALETTE_MEMORY_LOCATION, TileMap_PaletteLength * sizeof(u16) / sizeof(u32));
 }
 
-#define TILE_MEMORY_LOCATION ((u16 *)0x06000000)
+void TileMap_LoadCompressedBackgroundPalette(const void *compressedPaletteData)
+{
+    LostGBA_Decompress(compressedPaletteData, BG_PALETTE_MEMORY_LOCATION, true);
+}
+
+#define TILE_MEMORY_LOCATION ((u8 *)LOSTGBA_ADDRESS(0x06000000))
 
 void LOSTGBA_UNSAFE(TileMap_CopyToBackgroundTiles)(int tileNumber, const unsigned int *tileData, int length)
 {
-    memcpy(TILE_MEMORY_LOCATION + tileNumber * CHARBLOCK_SIZE, tileData, length);
+    Dma_Copy(tileData, TILE_MEMORY_LOCATION + tileNumber * CHARBLOCK_SIZE, length);
+}
+
+void LOSTGBA_UNSAFE(TileMap_LoadCompressedBackgroundTiles)(int tileNumber, const void *compressedTileData)
+{
+    LostGBA_Decompress(compressedTileData, TILE_MEMORY_LOCATION + tileNumber * CHARBLOCK_SIZE, true);
 }
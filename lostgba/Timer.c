@@ -0,0 +1,42 @@
+#include <lostgba/Timer.h>
+#include "LostGbaInternal.h"
+
+struct TimerRegisters
+{
+    vu16 count; // Reads give the current count, writes set the reload value
+    vu16 control;
+};
+
+static volatile struct TimerRegisters *Timer_registers = (volatile struct TimerRegisters *)LOSTGBA_ADDRESS(0x04000100);
+
+#define TIMER_ENABLE (1 << 7)
+#define TIMER_INTERRUPT (1 << 6)
+
+void Timer_Start(enum TimerNumber timer, u16 reload, struct TimerSettings settings)
+{
+    volatile struct TimerRegisters *registers = &Timer_registers[timer];
+
+    // The reload value is only copied into the counter when the enable bit goes from 0 to 1
+    registers->control = 0;
+    registers->count = reload;
+    registers->control = (settings.prescaler & LostGBA_AllOnes16(2)) |
+                         (settings.cascade << 2) |
+                         (settings.interruptOnOverflow << 6) |
+                         TIMER_ENABLE;
+}
+
+void Timer_Stop(enum TimerNumber timer)
+{
+    Timer_registers[timer].control &= ~TIMER_ENABLE;
+}
+
+u16 Timer_GetCount(enum TimerNumber timer)
+{
+    return Timer_registers[timer].count;
+}
+
+void Timer_SetInterruptEnabled(enum TimerNumber timer, bool enabled)
+{
+    volatile struct TimerRegisters *registers = &Timer_registers[timer];
+    registers->control = (registers->control & ~TIMER_INTERRUPT) | (enabled << 6);
+}
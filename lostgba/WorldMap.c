@@ -0,0 +1,132 @@
+#include <lostgba/WorldMap.h>
+#include <lostgba/Graphics.h>
+
+#include "LostGbaInternal.h"
+
+void WorldMap_Init(struct WorldMap *map, const u16 *entries, int width, int height,
+                   enum BackgroundNumber backgroundNumber, int screenBaseBlock, enum BackgroundSize backgroundSize)
+{
+    map->entries = entries;
+    map->width = width;
+    map->height = height;
+
+    map->backgroundNumber = backgroundNumber;
+    map->screenBaseBlock = screenBaseBlock;
+    map->backgroundSize = backgroundSize;
+
+    map->cameraX = 0;
+    map->cameraY = 0;
+
+    map->loadedTileX = 0;
+    map->loadedTileY = 0;
+    map->loaded = false;
+}
+
+void WorldMap_InitCompressed(struct WorldMap *map, const void *compressedEntries, u16 *buffer, int width, int height,
+                             enum BackgroundNumber backgroundNumber, int screenBaseBlock, enum BackgroundSize backgroundSize)
+{
+    LostGBA_Decompress(compressedEntries, buffer, false);
+    WorldMap_Init(map, buffer, width, height, backgroundNumber, screenBaseBlock, backgroundSize);
+}
+
+static int WorldMap_clamp(int value, int max)
+{
+    if (value > max)
+    {
+        value = max;
+    }
+
+    return value < 0 ? 0 : value;
+}
+
+void WorldMap_SetCamera(struct WorldMap *map, int x, int y)
+{
+    map->cameraX = WorldMap_clamp(x, map->width * 8 - Graphics_ScreenWidth);
+    map->cameraY = WorldMap_clamp(y, map->height * 8 - Graphics_ScreenHeight);
+}
+
+// The window is always inside the map, but the bottom / right edge of it can be one tile past the edge when the
+// camera is right at the end, so those tiles are skipped.
+static void WorldMap_writeRow(const struct WorldMap *map, int x, int y)
+{
+    if (y >= map->height)
+    {
+        return;
+    }
+
+    int length = WorldMap_WindowWidth;
+    if (x + length > map->width)
+    {
+        length = map->width - x;
+    }
+
+    LOSTGBA_UNSAFE(Background_SetRow)
+    (map->screenBaseBlock, map->backgroundSize, x, y, &map->entries[y * map->width + x], length);
+}
+
+static void WorldMap_writeColumn(const struct WorldMap *map, int x, int y)
+{
+    if (x >= map->width)
+    {
+        return;
+    }
+
+    int length = WorldMap_WindowHeight;
+    if (y + length > map->height)
+    {
+        length = map->height - y;
+    }
+
+    // Columns aren't contiguous in the map, so gather them up first
+    u16 column[WorldMap_WindowHeight];
+    const u16 *source = &map->entries[y * map->width + x];
+    for (int i = 0; i < length; i++)
+    {
+        column[i] = *source;
+        source += map->width;
+    }
+
+    LOSTGBA_UNSAFE(Background_SetColumn)
+    (map->screenBaseBlock, map->backgroundSize, x, y, column, length);
+}
+
+void WorldMap_Commit(struct WorldMap *map)
+{
+    int tileX = map->cameraX / 8;
+    int tileY = map->cameraY / 8;
+    int deltaX = tileX - map->loadedTileX;
+    int deltaY = tileY - map->loadedTileY;
+
+    bool farJump = deltaX >= WorldMap_WindowWidth || -deltaX >= WorldMap_WindowWidth ||
+                   deltaY >= WorldMap_WindowHeight || -deltaY >= WorldMap_WindowHeight;
+
+    if (!map->loaded || farJump)
+    {
+        for (int row = 0; row < WorldMap_WindowHeight; row++)
+        {
+            WorldMap_writeRow(map, tileX, tileY + row);
+        }
+
+        map->loaded = true;
+    }
+    else
+    {
+        // Columns which have come into view on the left or right. Written for the new rows so the corner is covered
+        int firstColumn = deltaX > 0 ? map->loadedTileX + WorldMap_WindowWidth : tileX;
+        for (int i = 0; i < (deltaX > 0 ? deltaX : -deltaX); i++)
+        {
+            WorldMap_writeColumn(map, firstColumn + i, tileY);
+        }
+
+        int firstRow = deltaY > 0 ? map->loadedTileY + WorldMap_WindowHeight : tileY;
+        for (int i = 0; i < (deltaY > 0 ? deltaY : -deltaY); i++)
+        {
+            WorldMap_writeRow(map, tileX, firstRow + i);
+        }
+    }
+
+    map->loadedTileX = tileX;
+    map->loadedTileY = tileY;
+
+    Background_SetScroll(map->backgroundNumber, map->cameraX, map->cameraY);
+}
@@ -0,0 +1,19 @@
+/**
+ * @file HostInternal.h
+ */
+
+#pragma once
+
+#include <lostgba/Host.h>
+
+/** Adds @p cycles to the count for @p region */
+void Host_AddCycles(enum HostMemoryRegion region, u32 cycles);
+
+/** Which region @p pointer is in. Pointers outside the memory image are ROM if read from, and IWRAM if written to */
+enum HostMemoryRegion Host_RegionOf(const volatile void *pointer, bool write);
+
+/** The cycles for one sequential 16 bit (or 32 bit if @p wide) access to @p region */
+u32 Host_AccessCycles(enum HostMemoryRegion region, bool wide);
+
+/** Counts the cycles for reading @p count units from @p source and writing them to @p destination */
+void Host_AccountTransfer(const volatile void *source, const volatile void *destination, u32 count, bool wide);
@@ -0,0 +1,201 @@
+#include <lostgba/Host.h>
+
+#include <string.h>
+
+#include "../LostGbaInternal.h"
+#include "HostInternal.h"
+
+u8 LostGBA_hostMemory[LOSTGBA_HOST_MEMORY_SIZE] LOSTGBA_ALIGN(4);
+
+void (*LostGBA_hostInterruptServiceRoutine)(void);
+
+static u32 Host_cycles[HostMemoryRegion_Count];
+
+void Host_Reset(void)
+{
+    memset(LostGBA_hostMemory, 0, sizeof(LostGBA_hostMemory));
+    LostGBA_hostInterruptServiceRoutine = NULL;
+    Host_ResetCycles();
+}
+
+void *Host_Address(u32 address)
+{
+    return &LostGBA_hostMemory[LOSTGBA_HOST_OFFSET(address)];
+}
+
+u32 Host_GetCycles(enum HostMemoryRegion region)
+{
+    return Host_cycles[region];
+}
+
+u32 Host_GetTotalCycles(void)
+{
+    u32 total = 0;
+    for (int i = 0; i < HostMemoryRegion_Count; i++)
+    {
+        total += Host_cycles[i];
+    }
+
+    return total;
+}
+
+void Host_ResetCycles(void)
+{
+    memset(Host_cycles, 0, sizeof(Host_cycles));
+}
+
+void Host_AddCycles(enum HostMemoryRegion region, u32 cycles)
+{
+    Host_cycles[region] += cycles;
+}
+
+// The start of each region within the memory image, in the same order as LOSTGBA_HOST_OFFSET lays them out
+static const struct
+{
+    u32 offset;
+    enum HostMemoryRegion region;
+} Host_regionStarts[] = {
+    {0x00000, HostMemoryRegion_Ewram},
+    {0x40000, HostMemoryRegion_Iwram},
+    {0x48000, HostMemoryRegion_Io},
+    {0x49400, HostMemoryRegion_Palette},
+    {0x49800, HostMemoryRegion_Vram},
+    {0x69800, HostMemoryRegion_Oam},
+};
+
+enum HostMemoryRegion Host_RegionOf(const volatile void *pointer, bool write)
+{
+    const volatile u8 *bytes = pointer;
+    if (bytes < LostGBA_hostMemory || bytes >= LostGBA_hostMemory + LOSTGBA_HOST_MEMORY_SIZE)
+    {
+        return write ? HostMemoryRegion_Iwram : HostMemoryRegion_Rom;
+    }
+
+    u32 offset = bytes - LostGBA_hostMemory;
+    int i = sizeof(Host_regionStarts) / sizeof(Host_regionStarts[0]) - 1;
+    while (Host_regionStarts[i].offset > offset)
+    {
+        i--;
+    }
+
+    return Host_regionStarts[i].region;
+}
+
+u32 Host_AccessCycles(enum HostMemoryRegion region, bool wide)
+{
+    // Sequential accesses, since everything counted here is a burst
+    switch (region)
+    {
+    case HostMemoryRegion_Rom:
+        return wide ? 4 : 2;
+    case HostMemoryRegion_Ewram:
+        return wide ? 6 : 3;
+    case HostMemoryRegion_Palette:
+    case HostMemoryRegion_Vram:
+        return wide ? 2 : 1;
+    default:
+        return 1;
+    }
+}
+
+void Host_AccountTransfer(const volatile void *source, const volatile void *destination, u32 count, bool wide)
+{
+    enum HostMemoryRegion sourceRegion = Host_RegionOf(source, false);
+    enum HostMemoryRegion destinationRegion = Host_RegionOf(destination, true);
+
+    Host_AddCycles(sourceRegion, count * Host_AccessCycles(sourceRegion, wide));
+    Host_AddCycles(destinationRegion, count * Host_AccessCycles(destinationRegion, wide));
+}
+
+void Host_RaiseInterrupt(enum InterruptType interruptType)
+{
+    vu16 *enabled = Host_Address(0x04000200);
+    vu16 *acknowledged = Host_Address(0x04000202);
+    vu16 *masterEnable = Host_Address(0x04000208);
+
+    *acknowledged |= 1 << interruptType;
+
+    if (*masterEnable && (*enabled & (1 << interruptType)) && LostGBA_hostInterruptServiceRoutine)
+    {
+        // The service routine acknowledges interrupts by writing them back to REG_IF, which clears them on hardware.
+        // Here the write just stores them, so clear them afterwards or they would be handled again next time
+        u16 acknowledging = *enabled & *acknowledged;
+        LostGBA_hostInterruptServiceRoutine();
+        *acknowledged &= ~acknowledging;
+    }
+}
+
+#define DMA_CONTROL_ADDRESS(channel) (0x040000B8 + (channel) * 12)
+
+#define DMA_DESTINATION_CONTROL(control) (((control) >> 5) & 3)
+#define DMA_SOURCE_CONTROL(control) (((control) >> 7) & 3)
+#define DMA_REPEAT (1 << 9)
+#define DMA_WIDE (1 << 10)
+#define DMA_TIMING(control) (((control) >> 12) & 3)
+#define DMA_INTERRUPT (1 << 14)
+#define DMA_ENABLE (1 << 15)
+
+// The cycles to get a DMA going, on top of the accesses themselves
+#define DMA_STARTUP_CYCLES 4
+
+static int Host_dmaStep(int addressControl, int unitSize)
+{
+    switch (addressControl)
+    {
+    case 1: // decrement
+        return -unitSize;
+    case 2: // fixed
+        return 0;
+    default: // increment, or increment and reload which is the same for one transfer
+        return unitSize;
+    }
+}
+
+void LostGBA_HostDmaTransfer(int channel, const volatile void *source, volatile void *destination, u32 count, u16 control)
+{
+    vu32 *controlRegister = Host_Address(DMA_CONTROL_ADDRESS(channel));
+
+    // Transfers waiting for hblank or vblank never happen, but keep them enabled so Dma_IsRunning() is right
+    if (DMA_TIMING(control) != 0)
+    {
+        *controlRegister = (count & 0xffff) | ((u32)control << 16);
+        return;
+    }
+
+    if (count == 0)
+    {
+        count = channel == 3 ? 0x10000 : 0x4000;
+    }
+
+    bool wide = control & DMA_WIDE;
+    int unitSize = wide ? 4 : 2;
+    int sourceStep = Host_dmaStep(DMA_SOURCE_CONTROL(control), unitSize);
+    int destinationStep = Host_dmaStep(DMA_DESTINATION_CONTROL(control), unitSize);
+
+    const volatile u8 *from = source;
+    volatile u8 *to = destination;
+    for (u32 i = 0; i < count; i++)
+    {
+        if (wide)
+        {
+            *(volatile u32 *)to = *(const volatile u32 *)from;
+        }
+        else
+        {
+            *(volatile u16 *)to = *(const volatile u16 *)from;
+        }
+
+        from += sourceStep;
+        to += destinationStep;
+    }
+
+    Host_AddCycles(HostMemoryRegion_Io, DMA_STARTUP_CYCLES);
+    Host_AccountTransfer(source, destination, count, wide);
+
+    *controlRegister = 0;
+
+    if (control & DMA_INTERRUPT)
+    {
+        Host_RaiseInterrupt(InterruptType_Dma0 + channel);
+    }
+}
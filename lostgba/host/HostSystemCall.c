@@ -0,0 +1,282 @@
+#include <lostgba/SystemCalls.h>
+
+#include <math.h>
+
+#include "../LostGbaInternal.h"
+#include "HostInternal.h"
+
+// Rough costs of the BIOS routines themselves, not counting the memory they read and write
+#define HOST_SWI_CYCLES 30
+#define HOST_DIV_CYCLES 60
+#define HOST_SQRT_CYCLES 140
+#define HOST_ARCTAN2_CYCLES 120
+#define HOST_CPU_SET_CYCLES_PER_UNIT 6
+#define HOST_CPU_FAST_SET_CYCLES_PER_WORD 1
+#define HOST_DECOMPRESS_CYCLES_PER_BYTE 12
+
+void SystemCall_Halt(void)
+{
+    Host_AddCycles(HostMemoryRegion_Bios, HOST_SWI_CYCLES);
+}
+
+void SystemCall_IntrWait(bool discardOldFlags, u16 interruptFlags)
+{
+    (void)discardOldFlags;
+
+    Host_AddCycles(HostMemoryRegion_Bios, HOST_SWI_CYCLES);
+
+    // Nothing else is going to raise the interrupt, so pretend the first one asked for has just happened
+    if (interruptFlags)
+    {
+        Host_RaiseInterrupt(__builtin_ctz(interruptFlags));
+    }
+}
+
+void SystemCall_WaitForVBlank(void)
+{
+    SystemCall_IntrWait(true, 1 << InterruptType_VBlank);
+}
+
+s32 SystemCall_DivMod(s32 numerator, s32 denominator, s32 *remainder)
+{
+    Host_AddCycles(HostMemoryRegion_Bios, HOST_DIV_CYCLES);
+
+    *remainder = numerator % denominator;
+    return numerator / denominator;
+}
+
+s32 SystemCall_Div(s32 numerator, s32 denominator)
+{
+    s32 remainder;
+    return SystemCall_DivMod(numerator, denominator, &remainder);
+}
+
+s32 SystemCall_Mod(s32 numerator, s32 denominator)
+{
+    s32 remainder;
+    SystemCall_DivMod(numerator, denominator, &remainder);
+    return remainder;
+}
+
+u16 SystemCall_Sqrt(u32 value)
+{
+    Host_AddCycles(HostMemoryRegion_Bios, HOST_SQRT_CYCLES);
+
+    u32 result = sqrt((double)value);
+
+    // Make sure rounding in the double doesn't take us past the true answer
+    while ((u64)result * result > value)
+    {
+        result--;
+    }
+
+    return result;
+}
+
+u16 SystemCall_ArcTan2(s16 x, s16 y)
+{
+    Host_AddCycles(HostMemoryRegion_Bios, HOST_ARCTAN2_CYCLES);
+
+    double angle = atan2(y, x);
+    if (angle < 0)
+    {
+        angle += 2 * M_PI;
+    }
+
+    return (u32)(angle / (2 * M_PI) * 0x10000) & 0xffff;
+}
+
+void SystemCall_CpuSet(const void *source, void *destination, u32 count, enum SystemCallCpuSetMode mode)
+{
+    bool fill = mode == SystemCallCpuSetMode_Fill16 || mode == SystemCallCpuSetMode_Fill32;
+    bool wide = mode == SystemCallCpuSetMode_Copy32 || mode == SystemCallCpuSetMode_Fill32;
+    count &= 0x1fffff;
+
+    for (u32 i = 0; i < count; i++)
+    {
+        u32 sourceIndex = fill ? 0 : i;
+
+        if (wide)
+        {
+            ((u32 *)destination)[i] = ((const u32 *)source)[sourceIndex];
+        }
+        else
+        {
+            ((u16 *)destination)[i] = ((const u16 *)source)[sourceIndex];
+        }
+    }
+
+    Host_AddCycles(HostMemoryRegion_Bios, HOST_SWI_CYCLES + count * HOST_CPU_SET_CYCLES_PER_UNIT);
+    Host_AccountTransfer(source, destination, count, wide);
+}
+
+void SystemCall_CpuFastSet(const void *source, void *destination, u32 wordCount, bool fill)
+{
+    // The BIOS always does whole blocks of 8 words
+    wordCount = ((wordCount & 0x1fffff) + 7) & ~7u;
+
+    for (u32 i = 0; i < wordCount; i++)
+    {
+        ((u32 *)destination)[i] = ((const u32 *)source)[fill ? 0 : i];
+    }
+
+    Host_AddCycles(HostMemoryRegion_Bios, HOST_SWI_CYCLES + wordCount * HOST_CPU_FAST_SET_CYCLES_PER_WORD);
+    Host_AccountTransfer(source, destination, wordCount, true);
+}
+
+// The decompressed size is in the top 24 bits of the header
+static u32 Host_decompressedSize(const u8 *source)
+{
+    return source[1] | (source[2] << 8) | (source[3] << 16);
+}
+
+static void Host_accountDecompression(const void *source, u32 sourceLength, volatile void *destination, u32 length)
+{
+    Host_AddCycles(HostMemoryRegion_Bios, HOST_SWI_CYCLES + length * HOST_DECOMPRESS_CYCLES_PER_BYTE);
+
+    // Reads are byte sized, and writes are counted as 16 bit since that's what the VRAM versions do
+    Host_AccountTransfer(source, source, sourceLength / 2, false);
+    Host_AccountTransfer(destination, destination, length / 2, false);
+}
+
+static void Host_lz77UnComp(const void *source, volatile void *destination)
+{
+    const u8 *in = source;
+    volatile u8 *out = destination;
+    u32 length = Host_decompressedSize(in);
+    u32 written = 0;
+
+    in += 4;
+    while (written < length)
+    {
+        u8 flags = *in++;
+
+        for (int bit = 7; bit >= 0 && written < length; bit--)
+        {
+            if (!(flags & (1 << bit)))
+            {
+                out[written++] = *in++;
+                continue;
+            }
+
+            int runLength = (in[0] >> 4) + 3;
+            u32 displacement = (((in[0] & 0xf) << 8) | in[1]) + 1;
+            in += 2;
+
+            for (int i = 0; i < runLength && written < length; i++, written++)
+            {
+                out[written] = out[written - displacement];
+            }
+        }
+    }
+
+    Host_accountDecompression(source, in - (const u8 *)source, destination, length);
+}
+
+static void Host_rlUnComp(const void *source, volatile void *destination)
+{
+    const u8 *in = source;
+    volatile u8 *out = destination;
+    u32 length = Host_decompressedSize(in);
+    u32 written = 0;
+
+    in += 4;
+    while (written < length)
+    {
+        u8 flag = *in++;
+
+        if (flag & 0x80)
+        {
+            int runLength = (flag & 0x7f) + 3;
+            u8 value = *in++;
+
+            for (int i = 0; i < runLength && written < length; i++)
+            {
+                out[written++] = value;
+            }
+        }
+        else
+        {
+            int runLength = flag + 1;
+
+            for (int i = 0; i < runLength && written < length; i++)
+            {
+                out[written++] = *in++;
+            }
+        }
+    }
+
+    Host_accountDecompression(source, in - (const u8 *)source, destination, length);
+}
+
+void SystemCall_LZ77UnCompWram(const void *source, void *destination)
+{
+    Host_lz77UnComp(source, destination);
+}
+
+void SystemCall_LZ77UnCompVram(const void *source, volatile void *destination)
+{
+    Host_lz77UnComp(source, destination);
+}
+
+void SystemCall_RLUnCompWram(const void *source, void *destination)
+{
+    Host_rlUnComp(source, destination);
+}
+
+void SystemCall_RLUnCompVram(const void *source, volatile void *destination)
+{
+    Host_rlUnComp(source, destination);
+}
+
+void SystemCall_HuffUnComp(const void *source, volatile void *destination)
+{
+    const u8 *in = source;
+    volatile u32 *out = destination;
+    u32 length = Host_decompressedSize(in);
+    int bitsPerSymbol = in[0] & 0xf;
+
+    // The tree starts after its size byte, and the bit stream after the tree
+    const u8 *tree = in + 5;
+    const u32 *bitStream = (const u32 *)(in + 4 + (in[4] + 1) * 2);
+
+    u32 written = 0;
+    u32 outputWord = 0;
+    int outputBits = 0;
+
+    const u8 *node = tree;
+    while (written < length)
+    {
+        u32 bits = *bitStream++;
+
+        for (int bit = 31; bit >= 0 && written < length; bit--)
+        {
+            int direction = (bits >> bit) & 1;
+            u8 nodeValue = *node;
+
+            // Children are stored in pairs, offset * 2 + 2 bytes on from the (even aligned) current node
+            const u8 *child = (const u8 *)((uintptr_t)node & ~(uintptr_t)1) + (nodeValue & 0x3f) * 2 + 2 + direction;
+            bool childIsData = nodeValue & (direction ? 0x40 : 0x80);
+
+            if (!childIsData)
+            {
+                node = child;
+                continue;
+            }
+
+            outputWord |= (u32)*child << outputBits;
+            outputBits += bitsPerSymbol;
+            node = tree;
+
+            if (outputBits == 32)
+            {
+                *out++ = outputWord;
+                written += 4;
+                outputWord = 0;
+                outputBits = 0;
+            }
+        }
+    }
+
+    Host_accountDecompression(source, (const u8 *)bitStream - in, destination, length);
+}
@@ -1,31 +1,96 @@
 #include <lostgba/Interrupt.h>
 #include <lostgba/ObjectAttribute.h>
+#include <lostgba/Sprite.h>
+#include <lostgba/SpriteTileStream.h>
+#include <lostgba/Animation.h>
+#include <lostgba/Fixed.h>
 #include <lostgba/TileMap.h>
 #include <lostgba/Background.h>
 #include <lostgba/Input.h>
 #include <lostgba/Graphics.h>
 #include <lostgba/SystemCalls.h>
+#include <lostgba/Profile.h>
+#include <lostgba/DebugLog.h>
+#include <lostgba/Sound.h>
+#include <lostgba/Palette.h>
+#include <lostgba/Text.h>
+#include <lostgba/Entity.h>
 
 #include <string.h>
 
 #include <whale.h>
 #include <tilemap.h>
 
+// Each frame of the whale is a 16x16 sprite, so 4 tiles
+#define WHALE_TILES_PER_FRAME 4
+
+struct SpriteTileStream whaleTileStream;
+
+// The tiles are in the same order for the blowing animation in every direction
+#define WHALE_BLOWING_FRAME_DURATION 4
+#define WHALE_BLOWING_FRAMES(firstTile, frameFlags)                                             \
+    {.tile = (firstTile) + 0, .duration = WHALE_BLOWING_FRAME_DURATION, .flags = (frameFlags)}, \
+    {.tile = (firstTile) + 1, .duration = WHALE_BLOWING_FRAME_DURATION, .flags = (frameFlags)}, \
+    {.tile = (firstTile) + 2, .duration = WHALE_BLOWING_FRAME_DURATION, .flags = (frameFlags)}, \
+    {.tile = (firstTile) + 3, .duration = WHALE_BLOWING_FRAME_DURATION, .flags = (frameFlags)}, \
+    {.tile = (firstTile) + 4, .duration = WHALE_BLOWING_FRAME_DURATION, .flags = (frameFlags)}, \
+    {.tile = (firstTile) + 5, .duration = WHALE_BLOWING_FRAME_DURATION, .flags = (frameFlags)}, \
+    {.tile = (firstTile) + 6, .duration = WHALE_BLOWING_FRAME_DURATION, .flags = (frameFlags)}, \
+    {.tile = (firstTile) + 7, .duration = WHALE_BLOWING_FRAME_DURATION, .flags = (frameFlags)}, \
+    {.tile = (firstTile) + 8, .duration = 1, .flags = (frameFlags)}
+
+enum WhaleDirection
+{
+    WhaleDirection_Left,
+    WhaleDirection_Up,
+    WhaleDirection_Right,
+    WhaleDirection_Down,
+};
+
+static const struct AnimationFrame whaleIdleLeftFrames[] = {{.tile = 0, .duration = 1}};
+static const struct AnimationFrame whaleIdleUpFrames[] = {{.tile = 3, .duration = 1}};
+static const struct AnimationFrame whaleIdleRightFrames[] = {{.tile = 2, .duration = 1}};
+static const struct AnimationFrame whaleIdleDownFrames[] = {{.tile = 1, .duration = 1}};
+
+static const struct AnimationFrame whaleBlowingLeftFrames[] = {WHALE_BLOWING_FRAMES(4, 0)};
+static const struct AnimationFrame whaleBlowingUpFrames[] = {WHALE_BLOWING_FRAMES(22, 0)};
+static const struct AnimationFrame whaleBlowingRightFrames[] = {WHALE_BLOWING_FRAMES(4, AnimationFrameFlag_HFlip)};
+static const struct AnimationFrame whaleBlowingDownFrames[] = {WHALE_BLOWING_FRAMES(13, 0)};
+
+static const struct AnimationClip whaleIdleClips[] = {
+    [WhaleDirection_Left] = ANIMATION_CLIP(whaleIdleLeftFrames, AnimationLoopMode_Loop),
+    [WhaleDirection_Up] = ANIMATION_CLIP(whaleIdleUpFrames, AnimationLoopMode_Loop),
+    [WhaleDirection_Right] = ANIMATION_CLIP(whaleIdleRightFrames, AnimationLoopMode_Loop),
+    [WhaleDirection_Down] = ANIMATION_CLIP(whaleIdleDownFrames, AnimationLoopMode_Loop),
+};
+
+static const struct AnimationClip whaleBlowingClips[] = {
+    [WhaleDirection_Left] = ANIMATION_CLIP(whaleBlowingLeftFrames, AnimationLoopMode_Once),
+    [WhaleDirection_Up] = ANIMATION_CLIP(whaleBlowingUpFrames, AnimationLoopMode_Once),
+    [WhaleDirection_Right] = ANIMATION_CLIP(whaleBlowingRightFrames, AnimationLoopMode_Once),
+    [WhaleDirection_Down] = ANIMATION_CLIP(whaleBlowingDownFrames, AnimationLoopMode_Once),
+};
+
+#define BOBBING_DELAY 20
+static const struct AnimationFrame bobbingFrames[] = {
+    {.duration = BOBBING_DELAY, .offsetY = 0},
+    {.duration = BOBBING_DELAY, .offsetY = 1},
+};
+static const struct AnimationClip bobbingClip = ANIMATION_CLIP(bobbingFrames, AnimationLoopMode_Loop);
+
 void setupSprites(void)
 {
-    TileMap_CopyToSpritePalette(whalePal);
-    TileMap_CopyToSpriteTiles(0, whaleTiles, whaleTilesLen);
+    Palette_LoadCompressed(PaletteType_Sprite, whalePal);
+    SpriteTileStream_Init(&whaleTileStream, whaleTiles, WHALE_TILES_PER_FRAME, 0);
 
-    for (int i = 0; i < 128; i++)
-    {
-        ObjectAttribute_SetDisplayMode(&objectAttributeBuffer[i], ObjectAttributeDisplayMode_Hidden);
-    }
+    Sprite_Init();
+    Entity_Init();
 }
 
 void setupTilemap(void)
 {
-    TileMap_CopyToBackgroundPalette(tilemapPal);
-    TileMap_CopyToBackgroundTiles(0, tilemapTiles, tilemapTilesLen);
+    Palette_LoadCompressed(PaletteType_Background, tilemapPal);
+    TileMap_LoadCompressedBackgroundTiles(0, tilemapTiles);
 }
 
 u32 randomNumber(void)
@@ -41,6 +106,8 @@ u32 randomNumber(void)
 
 void updateTilemapEntries(void)
 {
+    u16 row[32];
+
     for (int y = 0; y < 32; y++)
     {
         for (int x = 0; x < 32; x++)
@@ -48,33 +115,106 @@ void updateTilemapEntries(void)
             int r = randomNumber();
             int tileToUse = r & 1;
 
-            Background_SetTile(30, BackgroundSize_32x32, x, y, tileToUse, false, false, 0);
+            row[x] = Background_MakeScreenEntry(tileToUse, false, false, 0);
         }
+
+        Background_SetRow(30, BackgroundSize_32x32, 0, y, row, 32);
     }
 }
 
-int max(int a, int b)
+// A burst of noise which fades out, for when the whale blows. Generated at startup, and big enough that it is
+// better off in EWRAM than taking up IWRAM
+#define BLOW_SOUND_LENGTH (Sound_MixRate / 2)
+LOSTGBA_EWRAM_BSS static s8 blowSoundData[BLOW_SOUND_LENGTH];
+
+static const struct SoundSample blowSound = {
+    .data = blowSoundData,
+    .length = BLOW_SOUND_LENGTH,
+    .loopStart = Sound_NoLoop,
+    .rate = Sound_MixRate,
+};
+
+void setupSounds(void)
 {
-    return a > b ? a : b;
+    for (int i = 0; i < BLOW_SOUND_LENGTH; i++)
+    {
+        int envelope = BLOW_SOUND_LENGTH - i;
+        blowSoundData[i] = (s8)randomNumber() * envelope / BLOW_SOUND_LENGTH;
+    }
 }
 
-int min(int a, int b)
+// The HUD goes on BG1, in front of the tilemap, using the last background palette bank
+#define HUD_PALETTE_BANK 15
+#define HUD_COLOUR 1
+
+struct TextLayer hud;
+struct TextLabel titleLabel;
+
+void setupHud(void)
 {
-    return a < b ? a : b;
+    Background_SetColourMode(BackgroundNumber_1, BackgroundColourMode_4PP);
+    Background_SetSize(BackgroundNumber_1, BackgroundSize_32x32);
+    Background_SetScreenBaseBlock(BackgroundNumber_1, 31);
+    Background_SetTileBackgroundNumber(BackgroundNumber_1, 1);
+    Background_SetPriority(BackgroundNumber_1, 0);
+    Background_SetPriority(BackgroundNumber_0, 1);
+
+    Palette_SetColour(PaletteType_Background, HUD_PALETTE_BANK * Palette_BankLength + HUD_COLOUR, Palette_White);
+
+    TextLayer_Init(&hud, &Text_DefaultFont, (struct TextLayerSettings){
+                                                .tileBlock = 1,
+                                                .firstTile = 0,
+                                                .cachedGlyphs = 32,
+                                                .screenBaseBlock = 31,
+                                                .backgroundSize = BackgroundSize_32x32,
+                                                .paletteBank = HUD_PALETTE_BANK,
+                                                .colour = HUD_COLOUR,
+                                            });
+    TextLayer_Clear(&hud, 0, 0, 32, 32);
+    TextLayer_Print(&hud, 20, 0, "BLOWS");
+
+    TextLabel_Init(&titleLabel, &Text_DefaultFont, (struct TextLabelSettings){
+                                                       .tileBlock = 1,
+                                                       .firstTile = 64,
+                                                       .widthInTiles = 12,
+                                                       .screenBaseBlock = 31,
+                                                       .backgroundSize = BackgroundSize_32x32,
+                                                       .x = 0,
+                                                       .y = 0,
+                                                       .paletteBank = HUD_PALETTE_BANK,
+                                                       .colour = HUD_COLOUR,
+                                                   });
+    TextLabel_Set(&titleLabel, "The whale demo");
 }
 
+enum ProfileZoneId
+{
+    ProfileZoneId_UpdateTilemapEntries,
+    ProfileZoneId_CopyObjectAttributes,
+    ProfileZoneId_SoundMix,
+};
+
 int main(void)
 {
     struct GraphicsSettings graphicsSettings = {
         .graphicsMode = GraphicsMode_0,
         .enableBG0 = true,
+        .enableBG1 = true,
         .enableSprites = true};
     Graphics_SetMode(graphicsSettings);
 
     Interrupt_Init();
+    Input_EnableVBlankSampling();
+    Sound_Init();
     Interrupt_EnableType(InterruptType_VBlank);
     Interrupt_Enable();
 
+    DebugLog_Init();
+    Profile_Init();
+    Profile_SetZoneName(ProfileZoneId_UpdateTilemapEntries, "updateTilemapEntries");
+    Profile_SetZoneName(ProfileZoneId_CopyObjectAttributes, "ObjectAttributeBuffer_CopyBufferToMemory");
+    Profile_SetZoneName(ProfileZoneId_SoundMix, "Sound_Mix");
+
     Background_SetColourMode(BackgroundNumber_0, BackgroundColourMode_4PP);
     Background_SetSize(BackgroundNumber_0, BackgroundSize_32x32);
     Background_SetScreenBaseBlock(BackgroundNumber_0, 30);
@@ -84,129 +224,148 @@ int main(void)
     updateTilemapEntries();
 
     setupSprites();
-    ObjectAttributeBuffer_CopyBufferToMemory();
-
-    int x = 96;
-    int y = 32;
-
-    struct ObjectAttribute *whale = &objectAttributeBuffer[0];
-    ObjectAttribute_SetShape(whale, ObjectAttributeShape_Square);
-    ObjectAttribute_SetSize(whale, ObjectAttributeSize_16);
-    ObjectAttribute_SetPaletteBank(whale, 0);
-    ObjectAttribute_SetDisplayMode(whale, ObjectAttributeDisplayMode_Normal);
-    ObjectAttribute_SetGraphicsMode(whale, ObjectAttributeGraphicsMode_Normal);
+    setupSounds();
+    setupHud();
 
-    int tile = 0;
-    int bobbing = 0;
+    // Start from black and fade in over the first FADE_IN_FRAMES frames
+#define FADE_IN_FRAMES (Palette_MaxAmount / 2)
+    int fadeIn = FADE_IN_FRAMES;
+    Palette_Fade(Palette_AllBanks, Palette_Black, Palette_MaxAmount);
 
-#define BOBBING_MAX_DELAY 20
-    int bobbingTime = BOBBING_MAX_DELAY;
+    SpriteTileStream_Flush();
+    ObjectAttributeBuffer_CopyBufferToMemory();
+    PaletteBuffer_CopyBufferToMemory();
+
+#define WHALE_SPEED (Fixed16_One + Fixed16_One / 4)
+
+    EntityHandle whale = Entity_Create(Fixed16_FromInt(96), Fixed16_FromInt(32),
+                                       &(struct ObjectAttributeDescriptor){
+                                           .displayMode = ObjectAttributeDisplayMode_Normal,
+                                           .graphicsMode = ObjectAttributeGraphicsMode_Normal,
+                                           .shape = ObjectAttributeShape_Square,
+                                           .size = ObjectAttributeSize_16,
+                                           .paletteBank = 0,
+                                       });
+    Entity_SetEdgeMode(whale, EntityEdgeMode_Clamp);
+
+    // The whale's frames are streamed, so it is animated with an Animator rather than Entity_Play()
+    struct Animator whaleAnimator;
+    Animator_Init(&whaleAnimator, Sprite_GetAttribute(Entity_GetSprite(whale)), &whaleTileStream);
+    Animator_Play(&whaleAnimator, &whaleIdleClips[WhaleDirection_Left]);
+
+    // Doesn't draw anything, just moves the whale up and down
+    struct Animator bobbingAnimator;
+    Animator_Init(&bobbingAnimator, NULL, NULL);
+    Animator_Play(&bobbingAnimator, &bobbingClip);
 
     bool blowing = false;
-#define BLOWING_FRAMES 8
-#define BLOWING_FRAME_SKIP 4
-    int blowingFrame = 0;
+    int blowCount = 0;
+    TextLayer_PrintNumber(&hud, 26, 0, blowCount, 4);
 
 #define TILE_UPDATE_DELAY 40
     int tileUpdate = TILE_UPDATE_DELAY;
 
-    // 0 = left
-    // 1 = up
-    // 2 = right
-    // 3 = down
-    int direction = 0;
+    enum WhaleDirection direction = WhaleDirection_Left;
 
     while (true)
     {
         Input_UpdateKeyState();
-        int speed = 0;
+        Fixed16 speed = 0;
 
         if (Input_IsKeyDown(InputKey_Up))
         {
-            direction = 1;
-            speed = 1;
+            direction = WhaleDirection_Up;
+            speed = WHALE_SPEED;
         }
 
         if (Input_IsKeyDown(InputKey_Left))
         {
-            direction = 0;
-            speed = 1;
+            direction = WhaleDirection_Left;
+            speed = WHALE_SPEED;
         }
 
         if (Input_IsKeyDown(InputKey_Right))
         {
-            direction = 2;
-            speed = 1;
+            direction = WhaleDirection_Right;
+            speed = WHALE_SPEED;
         }
 
         if (Input_IsKeyDown(InputKey_Down))
         {
-            direction = 3;
-            speed = 1;
+            direction = WhaleDirection_Down;
+            speed = WHALE_SPEED;
         }
 
         if (Input_IsNewlyPressed(InputKey_A))
         {
             blowing = true;
+            TextLayer_PrintNumber(&hud, 26, 0, ++blowCount, 4);
+
+            // Pan towards whichever side of the screen the whale is on
+            int pan = (Fixed16_ToInt(Entity_GetX(whale)) + 8 - Graphics_ScreenWidth / 2) * Sound_MaxPan / (Graphics_ScreenWidth / 2);
+            Sound_Play(&blowSound, Sound_MaxVolume, pan);
+        }
+
+        if (Input_IsNewlyPressed(InputKey_Select))
+        {
+            Profile_Report();
         }
 
         switch (direction)
         {
-        case 0:
-            x -= speed;
-            x = max(x, 0);
-            tile = blowing ? 4 + blowingFrame / BLOWING_FRAME_SKIP : 0;
-            ObjectAttribute_SetHFlip(whale, false);
+        case WhaleDirection_Left:
+            Entity_SetVelocity(whale, -speed, 0);
             break;
-        case 1:
-            y -= speed;
-            y = max(y, 0);
-            tile = blowing ? 22 + blowingFrame / BLOWING_FRAME_SKIP : 3;
-            ObjectAttribute_SetHFlip(whale, false);
+        case WhaleDirection_Up:
+            Entity_SetVelocity(whale, 0, -speed);
             break;
-        case 2:
-            x += speed;
-            x = min(x, Graphics_ScreenWidth - 16);
-            tile = blowing ? 4 + blowingFrame / BLOWING_FRAME_SKIP : 2;
-            ObjectAttribute_SetHFlip(whale, blowing);
+        case WhaleDirection_Right:
+            Entity_SetVelocity(whale, speed, 0);
             break;
-        case 3:
-            y += speed;
-            y = min(y, Graphics_ScreenHeight - 16);
-            tile = blowing ? 13 + blowingFrame / BLOWING_FRAME_SKIP : 1;
-            ObjectAttribute_SetHFlip(whale, false);
+        case WhaleDirection_Down:
+            Entity_SetVelocity(whale, 0, speed);
             break;
         }
 
-        if (blowing)
-        {
-            if (blowingFrame >= BLOWING_FRAMES * BLOWING_FRAME_SKIP)
-            {
-                blowing = 0;
-                blowingFrame = 0;
-            }
-            else
-            {
-                blowingFrame++;
-            }
-        }
+        Animation_UpdateAll();
 
-        ObjectAttribute_SetTile(whale, tile * 4);
-        ObjectAttribute_SetPos(whale, x, y + bobbing);
-
-        if (--bobbingTime == 0)
+        if (blowing && Animator_IsFinished(&whaleAnimator))
         {
-            bobbing = !bobbing;
-            bobbingTime = BOBBING_MAX_DELAY;
+            blowing = false;
         }
 
+        Animator_Play(&whaleAnimator, blowing ? &whaleBlowingClips[direction] : &whaleIdleClips[direction]);
+        Entity_SetOffset(whale, bobbingAnimator.offsetX, bobbingAnimator.offsetY);
+        Entity_UpdateAll();
+
         if (--tileUpdate == 0)
         {
             tileUpdate = TILE_UPDATE_DELAY;
+
+            Profile_Begin(ProfileZoneId_UpdateTilemapEntries);
             updateTilemapEntries();
+            Profile_End(ProfileZoneId_UpdateTilemapEntries);
+        }
+
+        if (fadeIn > 0)
+        {
+            fadeIn--;
+            Palette_Fade(Palette_AllBanks, Palette_Black, fadeIn * Palette_MaxAmount / FADE_IN_FRAMES);
         }
 
+        Sprite_Commit();
         SystemCall_WaitForVBlank();
+
+        PaletteBuffer_CopyBufferToMemory();
+
+        SpriteTileStream_Flush();
+
+        Profile_Begin(ProfileZoneId_CopyObjectAttributes);
         ObjectAttributeBuffer_CopyBufferToMemory();
+        Profile_End(ProfileZoneId_CopyObjectAttributes);
+
+        Profile_Begin(ProfileZoneId_SoundMix);
+        Sound_Mix();
+        Profile_End(ProfileZoneId_SoundMix);
     }
 }
\ No newline at end of file
@@ -0,0 +1,517 @@
+// Regression tests for lostgba, run against the host build (see include/lostgba/Host.h). Build and run them with
+//
+//     make host-test
+//
+// Each test writes through the normal lostgba API and then checks the simulated memory image. Failures are printed
+// as they happen, and the exit status is non zero if anything failed.
+
+#include <lostgba/Animation.h>
+#include <lostgba/Background.h>
+#include <lostgba/Dma.h>
+#include <lostgba/Host.h>
+#include <lostgba/Input.h>
+#include <lostgba/Interrupt.h>
+#include <lostgba/ObjectAttribute.h>
+#include <lostgba/Sprite.h>
+#include <lostgba/SpriteMultiplexer.h>
+#include <lostgba/SpriteTileStream.h>
+#include <lostgba/SystemCalls.h>
+#include <lostgba/TileMap.h>
+
+#include <stdio.h>
+#include <string.h>
+
+static int hostTestFailures = 0;
+
+#define HOST_TEST_CHECK(condition)                                                   \
+    do                                                                               \
+    {                                                                                \
+        if (!(condition))                                                            \
+        {                                                                            \
+            printf("FAIL %s:%d %s: %s\n", __FILE__, __LINE__, __func__, #condition); \
+            hostTestFailures++;                                                      \
+        }                                                                            \
+    } while (0)
+
+#define HOST_TEST_SCREEN_BLOCK 24
+#define HOST_TEST_SCREEN_BLOCK_ADDRESS(block) (0x06000000 + (block) * 0x800)
+
+// Where tile (x, y) of a background lives, worked out the slow and obvious way from the layouts in BackgroundSize
+static u16 hostTestScreenEntry(int screenBlock, enum BackgroundSize size, int x, int y)
+{
+    int width = (size == BackgroundSize_64x32 || size == BackgroundSize_64x64) ? 64 : 32;
+    int blocksAcross = width / 32;
+    int block = screenBlock + (y / 32) * blocksAcross + x / 32;
+
+    const u16 *entries = Host_Address(HOST_TEST_SCREEN_BLOCK_ADDRESS(block));
+    return entries[(y % 32) * 32 + x % 32];
+}
+
+static void hostTestBackgroundSetTile(void)
+{
+    Host_Reset();
+
+    Background_SetTile(HOST_TEST_SCREEN_BLOCK, BackgroundSize_64x64, 40, 35, 0x123, true, false, 5);
+    Background_SetTile(HOST_TEST_SCREEN_BLOCK, BackgroundSize_32x32, 3, 4, 7, false, true, 0);
+
+    HOST_TEST_CHECK(hostTestScreenEntry(HOST_TEST_SCREEN_BLOCK, BackgroundSize_64x64, 40, 35) ==
+                    Background_MakeScreenEntry(0x123, true, false, 5));
+    HOST_TEST_CHECK(hostTestScreenEntry(HOST_TEST_SCREEN_BLOCK, BackgroundSize_32x32, 3, 4) ==
+                    Background_MakeScreenEntry(7, false, true, 0));
+
+    // Nothing else in the 4 screen blocks should have been touched
+    const u16 *entries = Host_Address(HOST_TEST_SCREEN_BLOCK_ADDRESS(HOST_TEST_SCREEN_BLOCK));
+    int written = 0;
+    for (int i = 0; i < 4 * 32 * 32; i++)
+    {
+        written += entries[i] != 0;
+    }
+
+    HOST_TEST_CHECK(written == 2);
+}
+
+static void hostTestBackgroundSetRow(void)
+{
+    static const enum BackgroundSize sizes[] = {
+        BackgroundSize_32x32,
+        BackgroundSize_64x32,
+        BackgroundSize_32x64,
+        BackgroundSize_64x64,
+    };
+
+    u16 row[40];
+    for (int i = 0; i < 40; i++)
+    {
+        row[i] = Background_MakeScreenEntry(i + 1, i & 1, i & 2, i & 15);
+    }
+
+    for (unsigned int s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++)
+    {
+        enum BackgroundSize size = sizes[s];
+        int width = (size == BackgroundSize_64x32 || size == BackgroundSize_64x64) ? 64 : 32;
+
+        // Odd and even starts, and rows which cross into the next screen block and wrap off the right edge
+        static const int starts[] = {0, 1, 13, 30, 31, 62};
+        for (unsigned int i = 0; i < sizeof(starts) / sizeof(starts[0]); i++)
+        {
+            int x = starts[i] % width;
+            int y = 33 % (size == BackgroundSize_32x64 || size == BackgroundSize_64x64 ? 64 : 32);
+
+            Host_Reset();
+            Background_SetRow(HOST_TEST_SCREEN_BLOCK, size, x, y, row, 40 < width ? 40 : width);
+
+            for (int j = 0; j < (40 < width ? 40 : width); j++)
+            {
+                HOST_TEST_CHECK(hostTestScreenEntry(HOST_TEST_SCREEN_BLOCK, size, (x + j) % width, y) == row[j]);
+            }
+        }
+    }
+}
+
+static void hostTestBackgroundScrollTable(void)
+{
+    Host_Reset();
+
+    Interrupt_Init();
+    Interrupt_EnableType(InterruptType_VBlank);
+    Interrupt_Enable();
+
+    Background_EnableScrollTable(BackgroundNumber_2);
+
+    struct BackgroundScrollOffset *table = Background_GetScrollTable();
+    for (int line = 0; line < Background_ScrollTableLength; line++)
+    {
+        table[line] = (struct BackgroundScrollOffset){.x = line, .y = 100 + line};
+    }
+    Background_SwapScrollTable();
+
+    // Nothing but the VBlank handler restarts the table, and it should do so every frame
+    vu32 *scroll = Host_Address(0x04000010 + BackgroundNumber_2 * 4);
+    for (int frame = 0; frame < 3; frame++)
+    {
+        Dma_Stop(DmaChannel_0);
+        *scroll = 0;
+
+        SystemCall_WaitForVBlank();
+
+        HOST_TEST_CHECK(*scroll == (0 | (100 << 16)));
+        HOST_TEST_CHECK(Dma_IsRunning(DmaChannel_0));
+    }
+
+    Background_DisableScrollTable();
+    Interrupt_DisableType(InterruptType_VBlank);
+}
+
+static void hostTestOamUpload(void)
+{
+    Host_Reset();
+
+    for (int i = 0; i < ObjectAttributeBuffer_Length; i++)
+    {
+        ObjectAttribute_Build(&objectAttributeBuffer[i], &(struct ObjectAttributeDescriptor){
+                                                             .x = i,
+                                                             .y = i / 2,
+                                                             .shape = ObjectAttributeShape_Square,
+                                                             .size = ObjectAttributeSize_16,
+                                                             .tileId = i * 4,
+                                                             .priority = i & 3,
+                                                         });
+    }
+
+    ObjectAttributeBuffer_MarkAllDirty();
+    ObjectAttributeBuffer_CopyBufferToMemory();
+
+    const struct ObjectAttribute *oam = Host_Address(0x07000000);
+    for (int i = 0; i < ObjectAttributeBuffer_Length; i++)
+    {
+        HOST_TEST_CHECK(oam[i].attr0 == objectAttributeBuffer[i].attr0);
+        HOST_TEST_CHECK(oam[i].attr1 == objectAttributeBuffer[i].attr1);
+        HOST_TEST_CHECK(oam[i].attr2 == objectAttributeBuffer[i].attr2);
+    }
+
+    // Nothing changed, so nothing should be uploaded
+    Host_ResetCycles();
+    ObjectAttributeBuffer_CopyBufferToMemory();
+    HOST_TEST_CHECK(Host_GetCycles(HostMemoryRegion_Oam) == 0);
+
+    // Only the group holding the changed attribute should be uploaded. Scribble over object attribute memory so
+    // that anything else being rewritten shows up
+    struct ObjectAttribute *scribbled = Host_Address(0x07000000);
+    for (int i = 0; i < ObjectAttributeBuffer_Length; i++)
+    {
+        scribbled[i].attr2 = 0xffff;
+    }
+
+    ObjectAttribute_SetPos(&objectAttributeBuffer[42], 100, 50);
+    ObjectAttributeBuffer_CopyBufferToMemory();
+
+    for (int i = 0; i < ObjectAttributeBuffer_Length; i++)
+    {
+        bool inChangedGroup = i / 4 == 42 / 4;
+        HOST_TEST_CHECK((oam[i].attr2 == objectAttributeBuffer[i].attr2) == inChangedGroup);
+    }
+
+    HOST_TEST_CHECK(oam[42].attr0 == objectAttributeBuffer[42].attr0);
+    HOST_TEST_CHECK(oam[42].attr1 == objectAttributeBuffer[42].attr1);
+}
+
+#define HOST_TEST_TILE_BYTES 256
+
+static u32 hostTestTiles[HOST_TEST_TILE_BYTES / 4];
+
+// All literals apart from a back reference repeating the previous 16 bytes, in the BIOS LZ77 format
+static u8 hostTestLz77[4 + HOST_TEST_TILE_BYTES * 2];
+static u32 hostTestLz77Length;
+
+static void hostTestBuildLz77(const u8 *data, u32 length)
+{
+    u8 *out = hostTestLz77;
+    *out++ = 0x10;
+    *out++ = length;
+    *out++ = length >> 8;
+    *out++ = length >> 16;
+
+    u32 position = 0;
+    while (position < length)
+    {
+        u8 *flags = out++;
+        *flags = 0;
+
+        for (int bit = 7; bit >= 0 && position < length; bit--)
+        {
+            if (position >= 16 && position + 16 <= length && !memcmp(data + position, data + position - 16, 16))
+            {
+                *flags |= 1 << bit;
+                *out++ = (16 - 3) << 4 | (16 - 1) >> 8;
+                *out++ = (16 - 1) & 0xff;
+                position += 16;
+            }
+            else
+            {
+                *out++ = data[position++];
+            }
+        }
+    }
+
+    hostTestLz77Length = out - hostTestLz77;
+}
+
+// Runs of 8 of the same byte, in the BIOS run length format
+static u8 hostTestRle[4 + HOST_TEST_TILE_BYTES];
+
+static void hostTestBuildRle(const u8 *data, u32 length)
+{
+    u8 *out = hostTestRle;
+    *out++ = 0x30;
+    *out++ = length;
+    *out++ = length >> 8;
+    *out++ = length >> 16;
+
+    for (u32 position = 0; position < length; position += 8)
+    {
+        *out++ = 0x80 | (8 - 3);
+        *out++ = data[position];
+    }
+}
+
+static void hostTestTileLoaders(void)
+{
+    u8 *bytes = (u8 *)hostTestTiles;
+    // Distinct bytes to start with, then alternating runs of 8 which repeat every 16 bytes so both formats compress it
+    for (int i = 0; i < HOST_TEST_TILE_BYTES; i++)
+    {
+        bytes[i] = i < 64 ? i : 5 + ((i / 8) & 1) * 0x11;
+    }
+
+    Host_Reset();
+    TileMap_CopyToBackgroundTiles(1, hostTestTiles, HOST_TEST_TILE_BYTES);
+    TileMap_CopyToSpriteTiles(1, hostTestTiles, HOST_TEST_TILE_BYTES);
+
+    HOST_TEST_CHECK(!memcmp(Host_Address(0x06004000), hostTestTiles, HOST_TEST_TILE_BYTES));
+    HOST_TEST_CHECK(!memcmp(Host_Address(0x06014000), hostTestTiles, HOST_TEST_TILE_BYTES));
+    HOST_TEST_CHECK(*(const u8 *)Host_Address(0x06004000 + HOST_TEST_TILE_BYTES) == 0);
+
+    hostTestBuildLz77(bytes, HOST_TEST_TILE_BYTES);
+    HOST_TEST_CHECK(hostTestLz77Length < 4 + HOST_TEST_TILE_BYTES);
+
+    Host_Reset();
+    TileMap_LoadCompressedBackgroundTiles(2, hostTestLz77);
+    TileMap_LoadCompressedSpriteTiles(0, hostTestLz77);
+
+    HOST_TEST_CHECK(!memcmp(Host_Address(0x06008000), hostTestTiles, HOST_TEST_TILE_BYTES));
+    HOST_TEST_CHECK(!memcmp(Host_Address(0x06010000), hostTestTiles, HOST_TEST_TILE_BYTES));
+
+    // Only the data past the first 64 bytes is made of runs
+    hostTestBuildRle(bytes + 64, HOST_TEST_TILE_BYTES - 64);
+
+    Host_Reset();
+    TileMap_LoadCompressedBackgroundTiles(3, hostTestRle);
+
+    HOST_TEST_CHECK(!memcmp(Host_Address(0x0600c000), bytes + 64, HOST_TEST_TILE_BYTES - 64));
+}
+
+static int hostTestVBlanks;
+static int hostTestVCounts;
+
+static void hostTestCountVBlank(void)
+{
+    hostTestVBlanks++;
+}
+
+static void hostTestCountVCount(void)
+{
+    hostTestVCounts++;
+}
+
+static void hostTestInterruptAcknowledge(void)
+{
+    Host_Reset();
+
+    Interrupt_Init();
+    Interrupt_AddHandler(InterruptType_VBlank, hostTestCountVBlank, 0);
+    Interrupt_AddHandler(InterruptType_VCount, hostTestCountVCount, 0);
+    Interrupt_EnableType(InterruptType_VBlank);
+    Interrupt_EnableType(InterruptType_VCount);
+    Interrupt_Enable();
+
+    SystemCall_WaitForVBlank();
+    Host_RaiseInterrupt(InterruptType_VCount);
+    Host_RaiseInterrupt(InterruptType_VCount);
+
+    // The service routine acknowledged the vblank, so it mustn't be handled again alongside the vcounts
+    HOST_TEST_CHECK(hostTestVBlanks == 1);
+    HOST_TEST_CHECK(hostTestVCounts == 2);
+
+    const vu16 *acknowledged = Host_Address(0x04000202);
+    HOST_TEST_CHECK(*acknowledged == 0);
+
+    Interrupt_RemoveHandler(InterruptType_VBlank, hostTestCountVBlank);
+    Interrupt_RemoveHandler(InterruptType_VCount, hostTestCountVCount);
+}
+
+static void hostTestSpriteMultiplexerBandLimit(void)
+{
+    Host_Reset();
+
+    Interrupt_Init();
+    Interrupt_EnableType(InterruptType_VBlank);
+    Interrupt_Enable();
+
+    Sprite_Init();
+    SpriteMultiplexer_Init(0);
+
+    // Every slot is taken until line 8, and then 8 more sprites than one band can copy all want to start on line 12
+    int extra = 8;
+    for (int i = 0; i < ObjectAttributeBuffer_Length + SpriteMultiplexer_MaxWritesPerBand + extra; i++)
+    {
+        ObjectAttribute_Build(SpriteMultiplexer_GetAttribute(SpriteMultiplexer_Alloc()),
+                              &(struct ObjectAttributeDescriptor){
+                                  .x = i % 200,
+                                  .y = i < ObjectAttributeBuffer_Length ? 0 : 12,
+                              });
+    }
+
+    SpriteMultiplexer_Commit();
+
+    struct SpriteMultiplexerStats stats = SpriteMultiplexer_GetStats();
+    HOST_TEST_CHECK(stats.visibleSprites == ObjectAttributeBuffer_Length + SpriteMultiplexer_MaxWritesPerBand + extra);
+    HOST_TEST_CHECK(stats.droppedSprites == extra);
+    HOST_TEST_CHECK(stats.bandCount == 1);
+
+    SystemCall_WaitForVBlank();
+    ObjectAttributeBuffer_CopyBufferToMemory();
+    Host_RaiseInterrupt(InterruptType_VCount);
+
+    const struct ObjectAttribute *oam = Host_Address(0x07000000);
+    int reused = 0;
+    for (int i = 0; i < ObjectAttributeBuffer_Length; i++)
+    {
+        reused += (oam[i].attr0 & 0xff) == 12;
+    }
+
+    HOST_TEST_CHECK(reused == SpriteMultiplexer_MaxWritesPerBand);
+
+    Interrupt_DisableType(InterruptType_VCount);
+}
+
+static void hostTestAnimatorStreamRetry(void)
+{
+    Host_Reset();
+    SpriteTileStream_Flush();
+
+    static const u32 sheet[2 * 8] = {[8] = 0x11111111};
+    static const struct AnimationFrame frames[] = {
+        {.tile = 1, .duration = 4},
+    };
+    static const struct AnimationClip clip = ANIMATION_CLIP(frames, AnimationLoopMode_Loop);
+
+    static struct ObjectAttribute attr;
+    static struct SpriteTileStream stream;
+    static struct SpriteTileStream fillers[SpriteTileStream_MaxQueued];
+    static struct Animator animator;
+
+    SpriteTileStream_Init(&stream, sheet, 1, 0);
+    SpriteTileStream_Flush();
+    HOST_TEST_CHECK(Animator_Init(&animator, &attr, &stream));
+
+    // With the queue full the frame can't be streamed yet, even though a single looping frame never changes again
+    for (int i = 0; i < SpriteTileStream_MaxQueued; i++)
+    {
+        SpriteTileStream_Init(&fillers[i], sheet, 1, 1);
+    }
+
+    Animator_Play(&animator, &clip);
+    HOST_TEST_CHECK(animator.pending);
+
+    SpriteTileStream_Flush();
+    Animation_UpdateAll();
+    HOST_TEST_CHECK(!animator.pending);
+    SpriteTileStream_Flush();
+
+    const u32 *tiles = Host_Address(0x06010000);
+    HOST_TEST_CHECK(tiles[0] == 0x11111111);
+
+    Animator_Remove(&animator);
+}
+
+// Checks Input_IsRepeating() gives @p expected, asking twice like a menu which checks the same key in two places
+static void hostTestCheckRepeat(bool expected, int line)
+{
+    for (int i = 0; i < 2; i++)
+    {
+        if (Input_IsRepeating(InputKey_A, 4, 2) != expected)
+        {
+            printf("FAIL %s:%d %s: repeat should be %d\n", __FILE__, line, __func__, expected);
+            hostTestFailures++;
+        }
+    }
+}
+
+static void hostTestInputRepeat(void)
+{
+    Host_Reset();
+
+    vu16 *keyInput = Host_Address(0x04000130);
+    *keyInput = 0x3ff;
+    Input_UpdateKeyState();
+
+    // Sampled once per update: newly pressed, then held counts 4, 6, 8 and so on
+    *keyInput = 0x3ff & ~(1 << InputKey_A);
+    bool expected[] = {true, false, false, true, false, true};
+    for (unsigned int i = 0; i < sizeof(expected) / sizeof(expected[0]); i++)
+    {
+        Input_UpdateKeyState();
+        hostTestCheckRepeat(expected[i], __LINE__);
+    }
+
+    Interrupt_Init();
+    Interrupt_EnableType(InterruptType_VBlank);
+    Interrupt_Enable();
+    Input_EnableVBlankSampling();
+
+    // A lagged update taking in held counts 7 to 9 still repeats on 8, and an update with no new
+    // samples doesn't repeat 10 a second time
+    for (int i = 0; i < 3; i++)
+    {
+        Host_RaiseInterrupt(InterruptType_VBlank);
+    }
+
+    Input_UpdateKeyState();
+    hostTestCheckRepeat(true, __LINE__);
+    HOST_TEST_CHECK(Input_HeldFrames(InputKey_A) == 9);
+
+    Host_RaiseInterrupt(InterruptType_VBlank);
+    Input_UpdateKeyState();
+    hostTestCheckRepeat(true, __LINE__);
+    Input_UpdateKeyState();
+    hostTestCheckRepeat(false, __LINE__);
+
+    // Released and pressed again within one update starts the schedule again rather than carrying on from before
+    *keyInput = 0x3ff;
+    Host_RaiseInterrupt(InterruptType_VBlank);
+    *keyInput = 0x3ff & ~(1 << InputKey_A);
+    for (int i = 0; i < 4; i++)
+    {
+        Host_RaiseInterrupt(InterruptType_VBlank);
+    }
+
+    Input_UpdateKeyState();
+    hostTestCheckRepeat(true, __LINE__);
+    HOST_TEST_CHECK(Input_HeldFrames(InputKey_A) == 4);
+
+    // Inverting the register sets the bits above the keys too, so they must never show up as pressed keys
+    *keyInput = 0;
+    Host_RaiseInterrupt(InterruptType_VBlank);
+    Input_UpdateKeyState();
+    HOST_TEST_CHECK((Input_NewlyPressedKeys() & ~0x3ff) == 0);
+
+    Interrupt_DisableType(InterruptType_VBlank);
+}
+
+int main(void)
+{
+    static const struct
+    {
+        const char *name;
+        void (*run)(void);
+    } tests[] = {
+        {"background_set_tile", hostTestBackgroundSetTile},
+        {"background_set_row", hostTestBackgroundSetRow},
+        {"background_scroll_table", hostTestBackgroundScrollTable},
+        {"oam_upload", hostTestOamUpload},
+        {"tile_loaders", hostTestTileLoaders},
+        {"interrupt_acknowledge", hostTestInterruptAcknowledge},
+        {"sprite_multiplexer_band_limit", hostTestSpriteMultiplexerBandLimit},
+        {"animator_stream_retry", hostTestAnimatorStreamRetry},
+        {"input_repeat", hostTestInputRepeat},
+    };
+
+    for (unsigned int i = 0; i < sizeof(tests) / sizeof(tests[0]); i++)
+    {
+        int failuresBefore = hostTestFailures;
+        tests[i].run();
+        printf("%s %s\n", hostTestFailures == failuresBefore ? "PASS" : "FAIL", tests[i].name);
+    }
+
+    return hostTestFailures ? 1 : 0;
+}
@@ -0,0 +1,50 @@
+#!/usr/bin/env sh
+# Runs grit over an image once per compression method and keeps whichever output is smallest.
+#
+# Usage: grit-smallest.sh [--raw-tiles] image.png [grit flags...]
+#
+# The .s and .h files end up next to the image, exactly like running grit directly. Palettes are always
+# compressed. With --raw-tiles the tiles are left uncompressed, which is needed for sprite sheets that are
+# streamed into VRAM a frame at a time.
+
+set -e
+
+tileCompression=yes
+if [ "$1" = "--raw-tiles" ]; then
+    tileCompression=no
+    shift
+fi
+
+image=$1
+shift
+
+name=$(basename "$image" .png)
+outputDir=$(dirname "$image")
+workDir=$(mktemp -d)
+trap 'rm -rf "$workDir"' EXIT
+
+bestSize=
+bestMethod=
+
+# l = LZ77, r = run length encoding. Both can be decompressed straight into VRAM by the BIOS.
+for method in l r; do
+    mkdir "$workDir/$method"
+    cp "$image" "$workDir/$method/"
+
+    flags="-pz$method"
+    if [ "$tileCompression" = yes ]; then
+        flags="$flags -gz$method"
+    fi
+
+    (cd "$workDir/$method" && grit "$name.png" "$@" $flags > /dev/null)
+
+    # grit writes a '#define <symbol>Len <bytes>' for every array it outputs
+    size=$(awk '$1 == "#define" && $2 ~ /Len$/ { total += $3 } END { print total + 0 }' "$workDir/$method/$name.h")
+
+    if [ -z "$bestSize" ] || [ "$size" -lt "$bestSize" ]; then
+        bestSize=$size
+        bestMethod=$method
+    fi
+done
+
+cp "$workDir/$bestMethod/$name.s" "$workDir/$bestMethod/$name.h" "$outputDir/"
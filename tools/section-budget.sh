@@ -0,0 +1,49 @@
+#!/usr/bin/env sh
+# Prints how much of each GBA memory region a linked elf uses, and fails if IWRAM or EWRAM has overflowed.
+#
+# Usage: section-budget.sh size-command file.elf [stack-reserve]
+#
+# size-command is the binutils size for the target (arm-none-eabi-size). Sections are put in a region by the address
+# size -A reports, which is their run address (VMA), so .data counts against IWRAM where it runs rather than ROM where
+# its initial values are stored. Those initial values, and the copies of code which runs from IWRAM, still take up
+# ROM, so the ROM figure is a slight underestimate.
+#
+# The stack grows down from the top of IWRAM (below the interrupt and supervisor stacks at 0x03007f00), so
+# stack-reserve bytes (default 2048) of IWRAM are kept back for it. The linker doesn't know how deep the stack
+# goes, so without this a build can fit IWRAM exactly and still crash the first time the stack runs into .bss.
+
+set -e
+
+sizeCommand=$1
+elf=$2
+stackReserve=${3:-2048}
+
+"$sizeCommand" -A -d "$elf" | awk -v stackReserve="$stackReserve" '
+    # Skip the header lines and sections which are not loaded (debug info etc. all have address 0)
+    NF != 3 || $3 !~ /^[0-9]+$/ || $3 == 0 { next }
+
+    {
+        region = int($3 / 16777216)
+        used[region] += $2
+        if (region == 3) {
+            iwramSections = iwramSections sprintf("    %-20s %6d\n", $1, $2)
+        }
+    }
+
+    function report(name, region, budget, note,    percent) {
+        percent = budget ? int(used[region] * 100 / budget) : 0
+        printf "[BUDGET] %-6s %8d / %8d bytes (%d%%)%s\n", name, used[region], budget, percent, note
+        if (used[region] > budget) {
+            printf "[BUDGET] %s overflowed by %d bytes\n", name, used[region] - budget
+            failed = 1
+        }
+    }
+
+    END {
+        report("ROM", 8, 32 * 1024 * 1024, " excluding .data and IWRAM code initialisers")
+        report("EWRAM", 2, 256 * 1024)
+        report("IWRAM", 3, 32512 - stackReserve) # everything below 0x03007f00
+        printf "%s", iwramSections
+        exit failed
+    }
+'